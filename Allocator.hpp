@@ -0,0 +1,224 @@
+/**
+ * @brief Aligned allocator for matrices and scratch arena for temporaries of algorithms
+ *
+ * @file Allocator.hpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace MatrixCpp {
+
+/**
+ * @brief Allocator which aligns memory to Alignment bytes (a cache line by default)
+ *
+ * @tparam T Type of elements
+ * @tparam Alignment Alignment in bytes
+ */
+template<typename T, std::size_t Alignment = 64>
+class AlignedAllocator {
+public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(std::size_t count) {
+        std::size_t bytes = (count * sizeof(T) + Alignment - 1) / Alignment * Alignment;
+        return static_cast<T*>(::operator new(bytes, std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T* pointer, std::size_t) noexcept {
+        ::operator delete(pointer, std::align_val_t(Alignment));
+    }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+
+    template<typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+template<typename T, typename Allocator = AlignedAllocator<T>>
+class Matrix;
+
+namespace detail {
+
+/**
+ * @brief Per-thread bump allocator for temporaries of library's algorithms
+ * @details Allocations are released in bulk, in reverse order, by ScratchBuffer going out of scope.
+ * When the arena runs out of space it takes extra blocks from the heap and, once everything
+ * is released, replaces the main block by one which also fits the most extra blocks that were
+ * alive at once. So after the first call of an algorithm repeated calls don't allocate at all.
+ *
+ */
+class ScratchArena {
+public:
+    static constexpr std::size_t Alignment = 64;
+
+    /**
+     * @brief Position in arena to release to
+     *
+     */
+    struct Mark {
+        std::size_t offset;
+        std::size_t overflows;
+    };
+
+    ScratchArena() : mBlock(nullptr), mCapacity(0), mOffset(0), mOverflowBytes(0), mPeakOverflowBytes(0) {}
+
+    ~ScratchArena() {
+        releaseOverflows(0);
+        if (mBlock != nullptr)
+            ::operator delete(mBlock, std::align_val_t(Alignment));
+    }
+
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    /**
+     * @brief Get arena of current thread
+     *
+     * @return ScratchArena& Arena
+     */
+    static ScratchArena& get() {
+        static thread_local ScratchArena arena;
+        return arena;
+    }
+
+    Mark getMark() const {
+        return Mark{mOffset, mOverflows.size()};
+    }
+
+    /**
+     * @brief Allocate aligned memory which lives until release() to earlier mark
+     *
+     * @param bytes Number of bytes
+     * @return void* Memory
+     */
+    void* allocate(std::size_t bytes) {
+        bytes = (bytes + Alignment - 1) / Alignment * Alignment;
+
+        if (mOffset + bytes <= mCapacity) {
+            void* memory = mBlock + mOffset;
+            mOffset += bytes;
+            return memory;
+        }
+
+        void* memory = ::operator new(bytes, std::align_val_t(Alignment));
+        mOverflows.push_back(Overflow{memory, bytes});
+        mOverflowBytes += bytes;
+        mPeakOverflowBytes = std::max(mPeakOverflowBytes, mOverflowBytes);
+        mOffset = mCapacity;
+        return memory;
+    }
+
+    /**
+     * @brief Release everything allocated after mark
+     *
+     * @param mark Mark
+     */
+    void release(const Mark& mark) {
+        releaseOverflows(mark.overflows);
+        mOffset = mark.offset;
+
+        if (mOffset == 0 && mPeakOverflowBytes > 0) {
+            std::size_t capacity = mCapacity + mPeakOverflowBytes;
+            if (mBlock != nullptr)
+                ::operator delete(mBlock, std::align_val_t(Alignment));
+
+            mBlock = static_cast<char*>(::operator new(capacity, std::align_val_t(Alignment)));
+            mCapacity = capacity;
+            mPeakOverflowBytes = 0;
+        }
+    }
+
+    /**
+     * @brief Get size of the main block in bytes
+     *
+     * @return std::size_t Capacity
+     */
+    std::size_t getCapacity() const {
+        return mCapacity;
+    }
+
+private:
+    /**
+     * @brief Block taken from the heap when the main one was full
+     *
+     */
+    struct Overflow {
+        void* memory;
+        std::size_t bytes;
+    };
+
+    void releaseOverflows(std::size_t count) {
+        while (mOverflows.size() > count) {
+            ::operator delete(mOverflows.back().memory, std::align_val_t(Alignment));
+            mOverflowBytes -= mOverflows.back().bytes;
+            mOverflows.pop_back();
+        }
+    }
+
+    char* mBlock;
+    std::size_t mCapacity;
+    std::size_t mOffset;
+    std::size_t mOverflowBytes;
+    std::size_t mPeakOverflowBytes;
+    std::vector<Overflow> mOverflows;
+};
+
+/**
+ * @brief Temporary array from arena of current thread, released when it goes out of scope
+ * @details Elements of trivial types aren't initialized. Buffers must be destroyed in reverse
+ * order of creation, which local variables always are.
+ *
+ * @tparam T Type of elements
+ */
+template<typename T>
+class ScratchBuffer {
+public:
+    explicit ScratchBuffer(std::size_t size)
+        : mArena(ScratchArena::get()), mMark(mArena.getMark()), mSize(size),
+          mData(size > 0 ? static_cast<T*>(mArena.allocate(size * sizeof(T))) : nullptr) {
+        if constexpr (!std::is_trivially_default_constructible<T>::value)
+            std::uninitialized_value_construct_n(mData, mSize);
+    }
+
+    ~ScratchBuffer() {
+        if constexpr (!std::is_trivially_destructible<T>::value)
+            std::destroy_n(mData, mSize);
+        mArena.release(mMark);
+    }
+
+    ScratchBuffer(const ScratchBuffer&) = delete;
+    ScratchBuffer& operator=(const ScratchBuffer&) = delete;
+
+    T* data() const { return mData; }
+    std::size_t size() const { return mSize; }
+    T& operator[](std::size_t index) const { return mData[index]; }
+
+private:
+    ScratchArena& mArena;
+    ScratchArena::Mark mMark;
+    std::size_t mSize;
+    T* mData;
+};
+
+}
+}
@@ -0,0 +1,450 @@
+/**
+ * @brief Cholesky decomposition of symmetric positive-definite matrices
+ *
+ * @file CholeskyDecomposition.hpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include "Allocator.hpp"
+#include "Gemm.hpp"
+#include "Instrumentation.hpp"
+#include "Matrix.hpp"
+#include "Simd.hpp"
+#include "ThreadPool.hpp"
+#include "Transpose.hpp"
+#include "Triangular.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace MatrixCpp {
+
+namespace detail {
+
+/**
+ * @brief Side of square tiles in which the lower triangle is stored and factored
+ *
+ */
+constexpr std::size_t CholeskyBlock = 128;
+
+/**
+ * @brief Right-hand sides are split into chunks of this many columns which are solved in parallel
+ *
+ */
+constexpr std::size_t CholeskySolveColumns = 256;
+
+/**
+ * @brief Number of elements in tiles of the lower triangle of size x size matrix
+ *
+ */
+inline std::size_t getCholeskyStorageSize(std::size_t size) {
+    std::size_t blocks = (size + CholeskyBlock - 1) / CholeskyBlock;
+    return blocks * (blocks + 1) / 2 * CholeskyBlock * CholeskyBlock;
+}
+
+/**
+ * @brief Tile (row, column) of the lower triangle, column <= row
+ * @details Tiles are stored row by row of tiles, each one row-major with stride CholeskyBlock
+ *
+ */
+template<typename T>
+T* getCholeskyTile(T* tiles, std::size_t row, std::size_t column) {
+    return tiles + (row * (row + 1) / 2 + column) * CholeskyBlock * CholeskyBlock;
+}
+
+/**
+ * @brief Factors diagonal tile in place: A = L * L^T, only the lower triangle is read and written
+ *
+ * @return bool Whether the tile is positive definite
+ */
+template<typename T>
+bool choleskyFactorizeTile(std::size_t size, T* a, std::size_t stride) {
+    const ElementwiseKernels<T>& kernels = getElementwiseKernels<T>();
+
+    for (std::size_t j = 0; j < size; ++j) {
+        T* rowJ = a + j * stride;
+        T diagonal = rowJ[j] - kernels.dot(rowJ, rowJ, j);
+
+        // Negated comparison also catches NaN
+        if (!(diagonal > T()))
+            return false;
+
+        diagonal = std::sqrt(diagonal);
+        rowJ[j] = diagonal;
+
+        for (std::size_t i = j + 1; i < size; ++i) {
+            T* rowI = a + i * stride;
+            rowI[j] = (rowI[j] - kernels.dot(rowI, rowJ, j)) / diagonal;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Solves X * L^T = A in place for rows x size tile A (X overwrites A)
+ * @details Transposed, it's L * X^T = A^T, which the blocked triangular solve does mostly by GEMM
+ *
+ */
+template<typename T>
+void choleskySolveTile(std::size_t rows, std::size_t size, const T* l, std::size_t strideL, T* a, std::size_t strideA) {
+    ScratchBuffer<T> transposed(size * rows);
+
+    transposeBlock(rows, size, a, strideA, transposed.data(), rows);
+    solveLowerTriangular(false, size, rows, l, strideL, transposed.data(), rows);
+    transposeBlock(size, rows, transposed.data(), rows, a, strideA);
+}
+
+/**
+ * @brief Right-looking tiled Cholesky factorization A = L * L^T of the lower triangle stored in tiles
+ * @details For every column of tiles the diagonal tile is factored, the tiles below it are solved
+ * in parallel and then every tile of the trailing lower triangle is updated by its own GEMM in parallel.
+ *
+ * @param size Size of A
+ * @param tiles Lower triangle of A in tiles (see getCholeskyTile), overwritten by L
+ * @return bool Whether A is positive definite
+ */
+template<typename T>
+bool choleskyFactorize(std::size_t size, T* tiles) {
+    const std::size_t blocks = (size + CholeskyBlock - 1) / CholeskyBlock;
+    const std::ptrdiff_t rs = static_cast<std::ptrdiff_t>(CholeskyBlock);
+    auto extent = [&](std::size_t block) { return std::min(CholeskyBlock, size - block * CholeskyBlock); };
+
+    for (std::size_t k = 0; k < blocks; ++k) {
+        const std::size_t width = extent(k);
+        const T* diagonal = getCholeskyTile(tiles, k, k);
+
+        if (!choleskyFactorizeTile(width, getCholeskyTile(tiles, k, k), CholeskyBlock))
+            return false;
+
+        const std::size_t rest = blocks - k - 1;
+
+        parallelFor(rest, [&](std::size_t index) {
+            std::size_t row = k + 1 + index;
+            choleskySolveTile(extent(row), width, diagonal, CholeskyBlock, getCholeskyTile(tiles, row, k), CholeskyBlock);
+        });
+
+        // A(i, j) -= L(i, k) * L(j, k)^T for k < j <= i
+        parallelFor(rest * (rest + 1) / 2, [&](std::size_t index) {
+            std::size_t i = static_cast<std::size_t>((std::sqrt(8.0 * static_cast<double>(index) + 1.0) - 1.0) / 2.0);
+            while (i * (i + 1) / 2 > index)
+                --i;
+            while ((i + 1) * (i + 2) / 2 <= index)
+                ++i;
+            std::size_t j = index - i * (i + 1) / 2;
+            i += k + 1;
+            j += k + 1;
+
+            gemm(extent(i), extent(j), width, T(-1),
+                 getCholeskyTile(tiles, i, k), rs, 1,
+                 getCholeskyTile(tiles, j, k), 1, rs,
+                 T(1), getCholeskyTile(tiles, i, j), rs, 1);
+        });
+    }
+
+    return true;
+}
+
+}
+
+/**
+ * @brief Cholesky decomposition A = L * L^T of symmetric positive-definite matrix
+ * @details Only the lower triangle of the matrix is read, and only the lower triangle of L is kept
+ * (in square tiles of CholeskyBlock), so it takes about half the memory and half the flops of LUDecomposition.
+ * Factorization is tiled: diagonal tiles are factored one after another, solves and GEMM updates
+ * of the other tiles run in parallel.
+ *
+ * @tparam T Type of matrix's elements (floating point)
+ */
+template<typename T>
+class CholeskyDecomposition {
+    static_assert(std::is_floating_point<T>::value, "Cholesky decomposition needs floating point type");
+
+public:
+    /**
+     * @brief Construct a new empty CholeskyDecomposition object
+     *
+     */
+    CholeskyDecomposition();
+
+    /**
+     * @brief Construct a new CholeskyDecomposition object with decomposition of given matrix
+     *
+     * @param matrix Matrix to get decomposition
+     */
+    CholeskyDecomposition(const Matrix<T>& matrix);
+
+    /**
+     * @brief Construct a new CholeskyDecomposition object with decomposition of given block or expression
+     *
+     * @param matrix Matrix expression (e.g. SubMatrixView) to get decomposition
+     */
+    template<typename E>
+    CholeskyDecomposition(const MatrixExpression<E, T>& matrix);
+
+    /**
+     * @brief Decomposes given matrix
+     *
+     * @param matrix Matrix to get decomposition
+     * @return true if decomposition was successfully gotten
+     * @return false if decomposition wasn't gotten (matrix isn't square or positive definite)
+     */
+    bool decompose(const Matrix<T>& matrix);
+
+    /**
+     * @brief Decomposes given block or expression without copying it into a matrix first
+     *
+     * @param matrix Matrix expression to get decomposition
+     * @return true if decomposition was successfully gotten
+     * @return false if decomposition wasn't gotten (matrix isn't square or positive definite)
+     */
+    template<typename E>
+    bool decompose(const MatrixExpression<E, T>& matrix);
+
+    /**
+     * @brief Get shared_ptr to L-matrix of decomposition (unpacked copy, A = L * L^T)
+     *
+     * @return std::shared_ptr<Matrix<T>> Lower triangular matrix (nullptr if decomposition is empty)
+     */
+    std::shared_ptr<Matrix<T>> getL() const;
+
+    /**
+     * @brief Get the size of decomposed matrix (Size x Size)
+     *
+     * @return std::size_t Size
+     */
+    std::size_t getSize() const;
+
+    /**
+     * @brief Check is decomposition empty or not (empty when given matrix isn't square or positive definite)
+     *
+     * @return bool Is empty
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Get natural logarithm of determinant of decomposed matrix
+     * @details Twice the sum of logarithms of L's diagonal, so it doesn't overflow where the determinant would
+     *
+     * @return T log(det(A)) (0 if decomposition is empty)
+     */
+    T logDeterminant() const;
+
+    /**
+     * @brief Solves A * x = b using stored decomposition
+     *
+     * @param b Right-hand side
+     * @return std::vector<T> Solution (empty if decomposition is empty or sizes don't fit)
+     */
+    std::vector<T> solve(const std::vector<T>& b) const;
+
+    /**
+     * @brief Solves A * X = B for all columns of B at once using stored decomposition
+     *
+     * @param B Right-hand sides
+     * @return Matrix<T> Solutions (empty if decomposition is empty or sizes don't fit)
+     */
+    Matrix<T> solve(const Matrix<T>& B) const;
+
+private:
+    /**
+     * @brief Replaces right-hand sides with solutions
+     *
+     * @param X Right-hand sides
+     */
+    void solveInPlace(Matrix<T>& X) const;
+
+    /**
+     * @brief Tiles of the lower triangle of L
+     *
+     */
+    std::vector<T, AlignedAllocator<T>> tiles;
+
+    /**
+     * @brief Size of the matrix
+     *
+     */
+    std::size_t size;
+
+    /**
+     * @brief Sets to true, if decomposition wasn't gotten
+     *
+     */
+    bool empty;
+};
+
+template<typename T>
+CholeskyDecomposition<T>::CholeskyDecomposition() {
+    size = 0;
+    empty = true;
+}
+
+template<typename T>
+CholeskyDecomposition<T>::CholeskyDecomposition(const Matrix<T>& matrix) {
+    decompose(matrix);
+}
+
+template<typename T>
+template<typename E>
+CholeskyDecomposition<T>::CholeskyDecomposition(const MatrixExpression<E, T>& matrix) {
+    decompose(matrix);
+}
+
+template<typename T>
+bool CholeskyDecomposition<T>::decompose(const Matrix<T>& matrix) {
+    return decompose(static_cast<const MatrixExpression<Matrix<T>, T>&>(matrix));
+}
+
+template<typename T>
+template<typename E>
+bool CholeskyDecomposition<T>::decompose(const MatrixExpression<E, T>& expression) {
+    const detail::DenseOperand<E> matrix(expression.derived());
+
+    if (matrix.getRows() != matrix.getColumns()) {
+        size = 0;
+        empty = true;
+        tiles.clear();
+        return !empty;
+    }
+
+    size = matrix.getRows();
+
+    MATRIXCPP_INSTRUMENT(CholeskyDecompose, 1.0 / 3.0 * size * size * size);
+
+    tiles.assign(detail::getCholeskyStorageSize(size), T());
+
+    for (std::size_t row = 0; row < size; ++row) {
+        const T* source = matrix.getData() + row * matrix.getStride();
+        std::size_t blockRow = row / detail::CholeskyBlock, offset = row % detail::CholeskyBlock;
+
+        for (std::size_t blockColumn = 0; blockColumn <= blockRow; ++blockColumn) {
+            std::size_t column = blockColumn * detail::CholeskyBlock;
+            std::size_t columns = blockColumn == blockRow ? offset + 1 : detail::CholeskyBlock;
+            std::copy_n(source + column, columns,
+                        detail::getCholeskyTile(tiles.data(), blockRow, blockColumn) + offset * detail::CholeskyBlock);
+        }
+    }
+
+    empty = !detail::choleskyFactorize(size, tiles.data());
+    if (empty) {
+        size = 0;
+        tiles.clear();
+    }
+
+    return !empty;
+}
+
+template<typename T>
+std::shared_ptr<Matrix<T>> CholeskyDecomposition<T>::getL() const {
+    if (empty)
+        return nullptr;
+
+    std::shared_ptr<Matrix<T>> lower = std::make_shared<Matrix<T>>(size, size);
+
+    for (std::size_t row = 0; row < size; ++row) {
+        T* target = lower->getData() + row * lower->getStride();
+        std::size_t blockRow = row / detail::CholeskyBlock, offset = row % detail::CholeskyBlock;
+
+        for (std::size_t blockColumn = 0; blockColumn <= blockRow; ++blockColumn) {
+            std::size_t column = blockColumn * detail::CholeskyBlock;
+            std::size_t columns = blockColumn == blockRow ? offset + 1 : detail::CholeskyBlock;
+            std::copy_n(detail::getCholeskyTile(tiles.data(), blockRow, blockColumn) + offset * detail::CholeskyBlock,
+                        columns, target + column);
+        }
+    }
+
+    return lower;
+}
+
+template<typename T>
+std::size_t CholeskyDecomposition<T>::getSize() const {
+    return size;
+}
+
+template<typename T>
+bool CholeskyDecomposition<T>::isEmpty() const {
+    return empty;
+}
+
+template<typename T>
+T CholeskyDecomposition<T>::logDeterminant() const {
+    T sum = T();
+
+    for (std::size_t i = 0; i < size; ++i) {
+        const T* tile = detail::getCholeskyTile(tiles.data(), i / detail::CholeskyBlock, i / detail::CholeskyBlock);
+        std::size_t offset = i % detail::CholeskyBlock;
+        sum += std::log(tile[offset * detail::CholeskyBlock + offset]);
+    }
+
+    return 2 * sum;
+}
+
+template<typename T>
+std::vector<T> CholeskyDecomposition<T>::solve(const std::vector<T>& b) const {
+    if (empty || b.size() != size)
+        return std::vector<T>();
+
+    MATRIXCPP_INSTRUMENT(CholeskySolve, 2.0 * size * size);
+
+    Matrix<T> X(size, 1);
+    std::copy(b.begin(), b.end(), X.getData());
+    solveInPlace(X);
+
+    return std::vector<T>(X.getData(), X.getData() + size);
+}
+
+template<typename T>
+Matrix<T> CholeskyDecomposition<T>::solve(const Matrix<T>& B) const {
+    if (empty || B.getRows() != size)
+        return Matrix<T>();
+
+    MATRIXCPP_INSTRUMENT(CholeskySolve, 2.0 * size * size * B.getColumns());
+
+    Matrix<T> X = B;
+    solveInPlace(X);
+
+    return X;
+}
+
+template<typename T>
+void CholeskyDecomposition<T>::solveInPlace(Matrix<T>& X) const {
+    const std::size_t blocks = (size + detail::CholeskyBlock - 1) / detail::CholeskyBlock;
+    const std::size_t columns = X.getColumns(), chunks = (columns + detail::CholeskySolveColumns - 1) / detail::CholeskySolveColumns;
+    const std::ptrdiff_t rs = static_cast<std::ptrdiff_t>(detail::CholeskyBlock), rsX = static_cast<std::ptrdiff_t>(X.getStride());
+    auto extent = [&](std::size_t block) { return std::min(detail::CholeskyBlock, size - block * detail::CholeskyBlock); };
+
+    parallelFor(chunks, [&](std::size_t chunk) {
+        std::size_t width = std::min(detail::CholeskySolveColumns, columns - chunk * detail::CholeskySolveColumns);
+        T* data = X.getData() + chunk * detail::CholeskySolveColumns;
+        auto rows = [&](std::size_t block) { return data + block * detail::CholeskyBlock * X.getStride(); };
+
+        // L * Y = B
+        for (std::size_t i = 0; i < blocks; ++i) {
+            for (std::size_t k = 0; k < i; ++k)
+                detail::gemm(extent(i), width, extent(k), T(-1), detail::getCholeskyTile(tiles.data(), i, k), rs, 1,
+                             rows(k), rsX, 1, T(1), rows(i), rsX, 1);
+            detail::solveLowerTriangular(false, extent(i), width, detail::getCholeskyTile(tiles.data(), i, i),
+                                         detail::CholeskyBlock, rows(i), X.getStride());
+        }
+
+        // L^T * X = Y: tiles of L^T are transposed tiles of L
+        detail::ScratchBuffer<T> upper(detail::CholeskyBlock * detail::CholeskyBlock);
+        for (std::size_t i = blocks; i-- > 0;) {
+            for (std::size_t k = i + 1; k < blocks; ++k)
+                detail::gemm(extent(i), width, extent(k), T(-1), detail::getCholeskyTile(tiles.data(), k, i), 1, rs,
+                             rows(k), rsX, 1, T(1), rows(i), rsX, 1);
+            detail::transposeBlock(extent(i), extent(i), detail::getCholeskyTile(tiles.data(), i, i), detail::CholeskyBlock,
+                                   upper.data(), detail::CholeskyBlock);
+            detail::solveUpperTriangular(false, extent(i), width, upper.data(), detail::CholeskyBlock, rows(i), X.getStride());
+        }
+    });
+}
+
+}
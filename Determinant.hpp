@@ -10,11 +10,19 @@
 
 #include "Matrix.hpp"
 #include "LUDecomposition.hpp"
+#include "FixedMatrix.hpp"
 
 #include <numeric>
 
 namespace MatrixCpp {
 
+/**
+ * @brief Determinant of square matrix
+ * @details Dynamic matrices are factored by task-parallel tiled LU (see LUDecomposition) and the determinant
+ * is the product of U's diagonal times the sign of the row permutation. Fixed matrices use the unrolled formulas.
+ * 
+ * @tparam T Type of matrix's elements
+ */
 template<typename T>
 class Determinant {
 public:
@@ -31,6 +39,22 @@ public:
      */
     Determinant(const Matrix<T>& matrix);
 
+    /**
+     * @brief Construct a new Determinant object with computing a determinant of given block or expression
+     * 
+     * @param matrix Matrix expression (e.g. SubMatrixView)
+     */
+    template<typename E>
+    Determinant(const MatrixExpression<E, T>& matrix);
+
+    /**
+     * @brief Construct a new Determinant object with computing a determinant of given fixed matrix
+     * 
+     * @param matrix Fixed square matrix
+     */
+    template<std::size_t N>
+    Determinant(const FixedMatrix<T, N, N>& matrix);
+
     /**
      * @brief Destroy the Determinant object
      * 
@@ -46,6 +70,25 @@ public:
      */
     bool computeDeterminant(const Matrix<T>& matrix);
 
+    /**
+     * @brief Compute determinant for given block or expression
+     * 
+     * @param matrix Matrix expression (e.g. SubMatrixView)
+     * @return true if determinant was successfully computed
+     * @return false if determinant wasn't computed
+     */
+    template<typename E>
+    bool computeDeterminant(const MatrixExpression<E, T>& matrix);
+
+    /**
+     * @brief Compute determinant for given fixed matrix (unrolled, no allocations)
+     * 
+     * @param matrix Fixed square matrix
+     * @return true as determinant is always computed
+     */
+    template<std::size_t N>
+    bool computeDeterminant(const FixedMatrix<T, N, N>& matrix);
+
     /**
      * @brief Checks: is determinant for matrix was computed
      * 
@@ -86,6 +129,18 @@ Determinant<T>::Determinant(const Matrix<T>& matrix) {
     computeDeterminant(matrix);
 }
 
+template<typename T>
+template<typename E>
+Determinant<T>::Determinant(const MatrixExpression<E, T>& matrix) {
+    computeDeterminant(matrix);
+}
+
+template<typename T>
+template<std::size_t N>
+Determinant<T>::Determinant(const FixedMatrix<T, N, N>& matrix) {
+    computeDeterminant(matrix);
+}
+
 template<typename T>
 Determinant<T>::~Determinant() {
 
@@ -93,6 +148,14 @@ Determinant<T>::~Determinant() {
 
 template<typename T>
 bool Determinant<T>::computeDeterminant(const Matrix<T>& matrix) {
+    return computeDeterminant(static_cast<const MatrixExpression<Matrix<T>, T>&>(matrix));
+}
+
+template<typename T>
+template<typename E>
+bool Determinant<T>::computeDeterminant(const MatrixExpression<E, T>& matrix) {
+    // Own work is the product of the diagonal, the decomposition is counted by its own hook
+    MATRIXCPP_INSTRUMENT(Determinant, matrix.derived().getRows() > 0 ? matrix.derived().getRows() - 1 : 0);
     LUDecomposition<T> decomposition(matrix);
 
     if (decomposition.isEmpty()) {
@@ -101,11 +164,19 @@ bool Determinant<T>::computeDeterminant(const Matrix<T>& matrix) {
         return false;
     }
 
-    std::vector<T> LDiag = decomposition.getL()->getDiagonalElements();
-    std::vector<T> UDiag = decomposition.getU()->getDiagonalElements();
-    determinant = std::accumulate(LDiag.begin(), LDiag.end(), 1, std::multiplies<T>());
-    determinant = std::accumulate(UDiag.begin(), UDiag.end(), determinant, std::multiplies<T>());
+    // det(A) = det(P) * det(U): L has unit diagonal
+    DiagonalView<const T> UDiag = decomposition.getFactors().getDiagonal();
+    determinant = std::accumulate(UDiag.begin(), UDiag.end(), T(decomposition.getPermutationSign()), std::multiplies<T>());
+
+    empty = false;
 
+    return !empty;
+}
+
+template<typename T>
+template<std::size_t N>
+bool Determinant<T>::computeDeterminant(const FixedMatrix<T, N, N>& matrix) {
+    determinant = MatrixCpp::determinant(matrix);
     empty = false;
 
     return !empty;
@@ -0,0 +1,342 @@
+/**
+ * @brief Matrix with sizes known at compile time
+ *
+ * @file FixedMatrix.hpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include "Matrix.hpp"
+#include "MatrixExpression.hpp"
+
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+namespace MatrixCpp {
+
+template<typename T, std::size_t R, std::size_t C>
+class FixedMatrix;
+
+namespace detail {
+
+template<typename F, std::size_t... I>
+constexpr void unrollImpl(F&& function, std::index_sequence<I...>) {
+    (function(std::integral_constant<std::size_t, I>()), ...);
+}
+
+/**
+ * @brief Calls function(std::integral_constant<std::size_t, I>()) for I in [0, N) without a loop
+ *
+ */
+template<std::size_t N, typename F>
+constexpr void unroll(F&& function) {
+    unrollImpl(function, std::make_index_sequence<N>());
+}
+
+template<typename T, std::size_t StrideB, std::size_t... K>
+constexpr T unrolledDot(const T* a, const T* b, std::index_sequence<K...>) {
+    return (T() + ... + (a[K] * b[K * StrideB]));
+}
+
+template<typename T, std::size_t R, std::size_t C>
+struct ExpressionOperand<FixedMatrix<T, R, C>> {
+    using Type = const FixedMatrix<T, R, C>&;
+};
+
+template<typename T, std::size_t R, std::size_t C>
+class DenseOperand<FixedMatrix<T, R, C>> {
+public:
+    explicit DenseOperand(const FixedMatrix<T, R, C>& matrix) : mData(matrix.getData()) {}
+
+    const T* getData() const { return mData; }
+    std::size_t getStride() const { return C; }
+    std::size_t getRows() const { return R; }
+    std::size_t getColumns() const { return C; }
+
+private:
+    const T* mData;
+};
+
+}
+
+/**
+ * @brief Matrix with R rows and C columns stored inline (no heap allocations)
+ * @details All operations are constexpr and unrolled at compile time, and mismatching sizes
+ * don't compile. It's a MatrixExpression, so it mixes with Matrix<T> in arithmetic
+ * and converts to it (Matrix<T> m = fixed;).
+ *
+ * @tparam T Type of elements
+ * @tparam R Number of rows
+ * @tparam C Number of columns
+ */
+template<typename T, std::size_t R, std::size_t C>
+class FixedMatrix : public MatrixExpression<FixedMatrix<T, R, C>, T> {
+    static_assert(R > 0 && C > 0, "FixedMatrix must have at least one row and one column");
+
+public:
+    using ValueType = T;
+
+    static constexpr std::size_t Rows = R;
+    static constexpr std::size_t Columns = C;
+
+    /**
+     * @brief Construct a new FixedMatrix object filled by zeros
+     *
+     */
+    constexpr FixedMatrix() : mData{} {}
+
+    /**
+     * @brief Construct a new FixedMatrix object filled by value
+     *
+     * @param value Value of every element
+     */
+    constexpr explicit FixedMatrix(const T& value) : mData{} {
+        detail::unroll<R * C>([&](auto i) { mData[i] = value; });
+    }
+
+    /**
+     * @brief Construct a new FixedMatrix object from lists of rows (missing elements are zeros)
+     *
+     * @param rows Rows
+     */
+    constexpr FixedMatrix(std::initializer_list<std::initializer_list<T>> rows) : mData{} {
+        std::size_t row = 0;
+        for (const auto& list : rows) {
+            if (row == R)
+                break;
+
+            std::size_t column = 0;
+            for (const T& value : list) {
+                if (column == C)
+                    break;
+                mData[row * C + column++] = value;
+            }
+            ++row;
+        }
+    }
+
+    /**
+     * @brief Construct a new FixedMatrix object from Matrix<T> or expression (zeros if sizes don't match)
+     *
+     * @param expression Matrix or expression
+     */
+    template<typename E>
+    explicit FixedMatrix(const MatrixExpression<E, T>& expression) : mData{} {
+        const E& source = expression.derived();
+        if (source.getRows() != R || source.getColumns() != C)
+            return;
+
+        for (std::size_t row = 0; row < R; ++row)
+            for (std::size_t column = 0; column < C; ++column)
+                mData[row * C + column] = source.get(row, column);
+    }
+
+    /**
+     * @brief Get identity matrix
+     *
+     * @return FixedMatrix Identity matrix
+     */
+    static constexpr FixedMatrix identity() {
+        static_assert(R == C, "Identity matrix must be square");
+
+        FixedMatrix result;
+        detail::unroll<R>([&](auto i) { result.mData[i * C + i] = T(1); });
+        return result;
+    }
+
+    static constexpr std::size_t getRows() { return R; }
+    static constexpr std::size_t getColumns() { return C; }
+    static constexpr std::size_t getStride() { return C; }
+    static constexpr bool isSquare() { return R == C; }
+
+    constexpr T* getData() { return mData; }
+    constexpr const T* getData() const { return mData; }
+
+    constexpr T get(std::size_t row, std::size_t column) const { return mData[row * C + column]; }
+    constexpr void set(std::size_t row, std::size_t column, const T& value) { mData[row * C + column] = value; }
+
+    constexpr T evaluate(std::size_t row, std::size_t column) const { return mData[row * C + column]; }
+    constexpr bool isConformable() const { return true; }
+    bool overlaps(const T* begin, const T* end) const { return detail::overlapsBlock(mData, R, C, C, begin, end); }
+
+    /**
+     * @brief Access to row (m[row][column])
+     *
+     * @param row Specific row
+     * @return T* Pointer to the first element of row
+     */
+    constexpr T* operator[](std::size_t row) { return mData + row * C; }
+    constexpr const T* operator[](std::size_t row) const { return mData + row * C; }
+
+    /**
+     * @brief Get transposed matrix
+     *
+     * @return FixedMatrix<T, C, R> Transposed matrix
+     */
+    constexpr FixedMatrix<T, C, R> transposed() const {
+        FixedMatrix<T, C, R> result;
+        detail::unroll<R * C>([&](auto i) { result.getData()[i % C * R + i / C] = mData[i]; });
+        return result;
+    }
+
+    constexpr FixedMatrix& operator+=(const FixedMatrix& rhs) {
+        detail::unroll<R * C>([&](auto i) { mData[i] += rhs.mData[i]; });
+        return *this;
+    }
+
+    constexpr FixedMatrix& operator-=(const FixedMatrix& rhs) {
+        detail::unroll<R * C>([&](auto i) { mData[i] -= rhs.mData[i]; });
+        return *this;
+    }
+
+    constexpr FixedMatrix& operator*=(const T& value) {
+        detail::unroll<R * C>([&](auto i) { mData[i] *= value; });
+        return *this;
+    }
+
+    constexpr FixedMatrix& operator/=(const T& value) {
+        detail::unroll<R * C>([&](auto i) { mData[i] /= value; });
+        return *this;
+    }
+
+    constexpr FixedMatrix& operator*=(const FixedMatrix<T, C, C>& rhs) {
+        return *this = *this * rhs;
+    }
+
+    friend constexpr FixedMatrix operator+(FixedMatrix lhs, const FixedMatrix& rhs) { return lhs += rhs; }
+    friend constexpr FixedMatrix operator-(FixedMatrix lhs, const FixedMatrix& rhs) { return lhs -= rhs; }
+    friend constexpr FixedMatrix operator*(FixedMatrix lhs, const T& rhs) { return lhs *= rhs; }
+    friend constexpr FixedMatrix operator*(const T& lhs, FixedMatrix rhs) { return rhs *= lhs; }
+    friend constexpr FixedMatrix operator/(FixedMatrix lhs, const T& rhs) { return lhs /= rhs; }
+
+    friend constexpr FixedMatrix operator-(FixedMatrix matrix) {
+        detail::unroll<R * C>([&](auto i) { matrix.mData[i] = -matrix.mData[i]; });
+        return matrix;
+    }
+
+    friend constexpr bool operator==(const FixedMatrix& lhs, const FixedMatrix& rhs) {
+        for (std::size_t i = 0; i < R * C; ++i)
+            if (!(lhs.mData[i] == rhs.mData[i]))
+                return false;
+        return true;
+    }
+
+    friend constexpr bool operator!=(const FixedMatrix& lhs, const FixedMatrix& rhs) { return !(lhs == rhs); }
+
+private:
+    T mData[R * C];
+};
+
+/**
+ * @brief Overloading for operator * (multiplying two fixed matrices, fully unrolled)
+ *
+ * @param lhs Left matrix (R x K)
+ * @param rhs Right matrix (K x C)
+ * @return FixedMatrix<T, R, C> Product
+ */
+template<typename T, std::size_t R, std::size_t K, std::size_t C>
+constexpr FixedMatrix<T, R, C> operator*(const FixedMatrix<T, R, K>& lhs, const FixedMatrix<T, K, C>& rhs) {
+    FixedMatrix<T, R, C> result;
+    detail::unroll<R * C>([&](auto i) {
+        constexpr std::size_t row = decltype(i)::value / C, column = decltype(i)::value % C;
+        result.getData()[i] = detail::unrolledDot<T, C>(lhs.getData() + row * K, rhs.getData() + column, std::make_index_sequence<K>());
+    });
+    return result;
+}
+
+/**
+ * @brief Fixed matrices of mismatching sizes can't be added, subtracted or multiplied
+ *
+ */
+template<typename T, std::size_t R1, std::size_t C1, std::size_t R2, std::size_t C2>
+void operator+(const FixedMatrix<T, R1, C1>&, const FixedMatrix<T, R2, C2>&) = delete;
+
+template<typename T, std::size_t R1, std::size_t C1, std::size_t R2, std::size_t C2>
+void operator-(const FixedMatrix<T, R1, C1>&, const FixedMatrix<T, R2, C2>&) = delete;
+
+template<typename T, std::size_t R1, std::size_t C1, std::size_t R2, std::size_t C2>
+void operator*(const FixedMatrix<T, R1, C1>&, const FixedMatrix<T, R2, C2>&) = delete;
+
+/**
+ * @brief Determinant of fixed square matrix
+ * @details Closed formulas (fully unrolled) up to 4 x 4, Gaussian elimination
+ * with partial pivoting for bigger matrices
+ *
+ * @param m Matrix
+ * @return T Determinant
+ */
+template<typename T, std::size_t N>
+constexpr T determinant(const FixedMatrix<T, N, N>& m) {
+    if constexpr (N == 1) {
+        return m.get(0, 0);
+    } else if constexpr (N == 2) {
+        return m.get(0, 0) * m.get(1, 1) - m.get(0, 1) * m.get(1, 0);
+    } else if constexpr (N == 3) {
+        return m.get(0, 0) * (m.get(1, 1) * m.get(2, 2) - m.get(1, 2) * m.get(2, 1))
+             - m.get(0, 1) * (m.get(1, 0) * m.get(2, 2) - m.get(1, 2) * m.get(2, 0))
+             + m.get(0, 2) * (m.get(1, 0) * m.get(2, 1) - m.get(1, 1) * m.get(2, 0));
+    } else if constexpr (N == 4) {
+        // Expansion by 2 x 2 minors of the top two rows and the bottom two rows
+        T s0 = m.get(0, 0) * m.get(1, 1) - m.get(1, 0) * m.get(0, 1);
+        T s1 = m.get(0, 0) * m.get(1, 2) - m.get(1, 0) * m.get(0, 2);
+        T s2 = m.get(0, 0) * m.get(1, 3) - m.get(1, 0) * m.get(0, 3);
+        T s3 = m.get(0, 1) * m.get(1, 2) - m.get(1, 1) * m.get(0, 2);
+        T s4 = m.get(0, 1) * m.get(1, 3) - m.get(1, 1) * m.get(0, 3);
+        T s5 = m.get(0, 2) * m.get(1, 3) - m.get(1, 2) * m.get(0, 3);
+
+        T c5 = m.get(2, 2) * m.get(3, 3) - m.get(3, 2) * m.get(2, 3);
+        T c4 = m.get(2, 1) * m.get(3, 3) - m.get(3, 1) * m.get(2, 3);
+        T c3 = m.get(2, 1) * m.get(3, 2) - m.get(3, 1) * m.get(2, 2);
+        T c2 = m.get(2, 0) * m.get(3, 3) - m.get(3, 0) * m.get(2, 3);
+        T c1 = m.get(2, 0) * m.get(3, 2) - m.get(3, 0) * m.get(2, 2);
+        T c0 = m.get(2, 0) * m.get(3, 1) - m.get(3, 0) * m.get(2, 1);
+
+        return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    } else {
+        FixedMatrix<T, N, N> a = m;
+        T result = T(1);
+
+        for (std::size_t k = 0; k < N; ++k) {
+            std::size_t pivot = k;
+            for (std::size_t row = k + 1; row < N; ++row)
+                if ((a[pivot][k] < T() ? -a[pivot][k] : a[pivot][k]) < (a[row][k] < T() ? -a[row][k] : a[row][k]))
+                    pivot = row;
+
+            if (a[pivot][k] == T())
+                return T();
+
+            if (pivot != k) {
+                for (std::size_t column = 0; column < N; ++column) {
+                    T value = a[k][column];
+                    a[k][column] = a[pivot][column];
+                    a[pivot][column] = value;
+                }
+                result = -result;
+            }
+
+            result *= a[k][k];
+            for (std::size_t row = k + 1; row < N; ++row) {
+                T factor = a[row][k] / a[k][k];
+                for (std::size_t column = k + 1; column < N; ++column)
+                    a[row][column] -= factor * a[k][column];
+            }
+        }
+
+        return result;
+    }
+}
+
+template<typename T>
+using Matrix2 = FixedMatrix<T, 2, 2>;
+
+template<typename T>
+using Matrix3 = FixedMatrix<T, 3, 3>;
+
+template<typename T>
+using Matrix4 = FixedMatrix<T, 4, 4>;
+
+}
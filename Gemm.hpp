@@ -0,0 +1,268 @@
+/**
+ * @brief Cache-blocked matrix multiplication kernel
+ *
+ * @file Gemm.hpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include "Allocator.hpp"
+#include "ThreadPool.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <algorithm>
+
+namespace MatrixCpp {
+namespace detail {
+
+/**
+ * @brief Blocking parameters of GEMM for type T
+ * @details MR x NR is the register tile of micro-kernel, KC x NR panel of B lives in L1,
+ * MC x KC block of A lives in L2 and KC x NC panel of B lives in L3
+ *
+ * @tparam T Type of elements
+ */
+template<typename T>
+struct GemmBlocking {
+    static constexpr std::size_t MR = 6;
+    static constexpr std::size_t NR = sizeof(T) <= 16 ? std::max<std::size_t>(64 / sizeof(T), 4) : 4;
+    static constexpr std::size_t KC = 256;
+    static constexpr std::size_t MC = std::max<std::size_t>((256 * 1024 / (KC * sizeof(T))) / MR, 1) * MR;
+    static constexpr std::size_t NC = 4096 / NR * NR;
+
+    /**
+     * @brief Products with fewer multiply-adds (m * n * k) than this run on one thread
+     *
+     */
+    static constexpr double ParallelThreshold = 64.0 * 64.0 * 64.0;
+};
+
+/**
+ * @brief Packs mc x kc block of A into row micro-panels of MR rows (padded by zeros)
+ *
+ */
+template<typename T>
+void gemmPackA(std::size_t mc, std::size_t kc, const T* a, std::ptrdiff_t rsA, std::ptrdiff_t csA, T* packed) {
+    constexpr std::size_t MR = GemmBlocking<T>::MR;
+
+    for (std::size_t ir = 0; ir < mc; ir += MR) {
+        std::size_t mr = std::min(MR, mc - ir);
+        const T* panel = a + static_cast<std::ptrdiff_t>(ir) * rsA;
+
+        for (std::size_t p = 0; p < kc; ++p) {
+            const T* column = panel + static_cast<std::ptrdiff_t>(p) * csA;
+            std::size_t i = 0;
+            for (; i < mr; ++i)
+                packed[i] = column[static_cast<std::ptrdiff_t>(i) * rsA];
+            for (; i < MR; ++i)
+                packed[i] = T();
+            packed += MR;
+        }
+    }
+}
+
+/**
+ * @brief Packs kc x nc panel of B into column micro-panels of NR columns (padded by zeros)
+ *
+ */
+template<typename T>
+void gemmPackB(std::size_t kc, std::size_t nc, const T* b, std::ptrdiff_t rsB, std::ptrdiff_t csB, T* packed) {
+    constexpr std::size_t NR = GemmBlocking<T>::NR;
+
+    for (std::size_t jr = 0; jr < nc; jr += NR) {
+        std::size_t nr = std::min(NR, nc - jr);
+        const T* panel = b + static_cast<std::ptrdiff_t>(jr) * csB;
+
+        for (std::size_t p = 0; p < kc; ++p) {
+            const T* row = panel + static_cast<std::ptrdiff_t>(p) * rsB;
+            std::size_t j = 0;
+            if (csB == 1) {
+                for (; j < nr; ++j)
+                    packed[j] = row[j];
+            } else {
+                for (; j < nr; ++j)
+                    packed[j] = row[static_cast<std::ptrdiff_t>(j) * csB];
+            }
+            for (; j < NR; ++j)
+                packed[j] = T();
+            packed += NR;
+        }
+    }
+}
+
+/**
+ * @brief Register micro-kernel: C = beta * C + alpha * A * B for one MR x NR tile
+ * @details Accumulates the whole tile in a local array which compiler keeps in vector registers,
+ * only mr x nr corner is written back (the rest is packing padding)
+ *
+ */
+template<typename T>
+inline void gemmMicroKernel(std::size_t kc, const T* a, const T* b, T alpha, T beta,
+                            T* c, std::ptrdiff_t rsC, std::ptrdiff_t csC, std::size_t mr, std::size_t nr) {
+    constexpr std::size_t MR = GemmBlocking<T>::MR;
+    constexpr std::size_t NR = GemmBlocking<T>::NR;
+
+    T ab[MR * NR];
+
+#if defined(__GNUC__)
+    if constexpr (std::is_arithmetic<T>::value && NR * sizeof(T) == 64) {
+        // One row of the tile is exactly one 64-byte vector
+        typedef T Vector __attribute__((vector_size(64)));
+
+        Vector accumulators[MR];
+        for (std::size_t i = 0; i < MR; ++i)
+            accumulators[i] = Vector{};
+
+        for (std::size_t p = 0; p < kc; ++p) {
+            Vector bp;
+            std::memcpy(&bp, b, sizeof(Vector));
+            for (std::size_t i = 0; i < MR; ++i)
+                accumulators[i] += a[i] * bp;
+            a += MR;
+            b += NR;
+        }
+
+        std::memcpy(ab, accumulators, sizeof(accumulators));
+    } else
+#endif
+    {
+        for (std::size_t i = 0; i < MR * NR; ++i)
+            ab[i] = T();
+
+        for (std::size_t p = 0; p < kc; ++p) {
+            for (std::size_t i = 0; i < MR; ++i) {
+                const T ai = a[i];
+                for (std::size_t j = 0; j < NR; ++j)
+                    ab[i * NR + j] += ai * b[j];
+            }
+            a += MR;
+            b += NR;
+        }
+    }
+
+    for (std::size_t i = 0; i < mr; ++i) {
+        T* row = c + static_cast<std::ptrdiff_t>(i) * rsC;
+        if (beta == T()) {
+            for (std::size_t j = 0; j < nr; ++j)
+                row[static_cast<std::ptrdiff_t>(j) * csC] = alpha * ab[i * NR + j];
+        } else {
+            for (std::size_t j = 0; j < nr; ++j) {
+                T& el = row[static_cast<std::ptrdiff_t>(j) * csC];
+                el = beta * el + alpha * ab[i * NR + j];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Single-threaded C = alpha * A * B + beta * C (see gemm())
+ *
+ */
+template<typename T>
+void gemmSerial(std::size_t m, std::size_t n, std::size_t k, T alpha,
+          const T* a, std::ptrdiff_t rsA, std::ptrdiff_t csA,
+          const T* b, std::ptrdiff_t rsB, std::ptrdiff_t csB,
+          T beta, T* c, std::ptrdiff_t rsC, std::ptrdiff_t csC) {
+    using Blocking = GemmBlocking<T>;
+    constexpr std::size_t MR = Blocking::MR, NR = Blocking::NR;
+
+    if (m == 0 || n == 0)
+        return;
+
+    if (k == 0 || alpha == T()) {
+        for (std::size_t i = 0; i < m; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                T& el = c[static_cast<std::ptrdiff_t>(i) * rsC + static_cast<std::ptrdiff_t>(j) * csC];
+                el = beta == T() ? T() : beta * el;
+            }
+        }
+        return;
+    }
+
+    std::size_t kcMax = std::min(Blocking::KC, k);
+    ScratchBuffer<T> packedA(std::min(Blocking::MC, (m + MR - 1) / MR * MR) * kcMax);
+    ScratchBuffer<T> packedB(std::min(Blocking::NC, (n + NR - 1) / NR * NR) * kcMax);
+
+    for (std::size_t jc = 0; jc < n; jc += Blocking::NC) {
+        std::size_t nc = std::min(Blocking::NC, n - jc);
+
+        for (std::size_t pc = 0; pc < k; pc += Blocking::KC) {
+            std::size_t kc = std::min(Blocking::KC, k - pc);
+            T betaBlock = pc == 0 ? beta : T(1);
+
+            gemmPackB(kc, nc, b + static_cast<std::ptrdiff_t>(pc) * rsB + static_cast<std::ptrdiff_t>(jc) * csB,
+                      rsB, csB, packedB.data());
+
+            for (std::size_t ic = 0; ic < m; ic += Blocking::MC) {
+                std::size_t mc = std::min(Blocking::MC, m - ic);
+
+                gemmPackA(mc, kc, a + static_cast<std::ptrdiff_t>(ic) * rsA + static_cast<std::ptrdiff_t>(pc) * csA,
+                          rsA, csA, packedA.data());
+
+                for (std::size_t jr = 0; jr < nc; jr += NR) {
+                    std::size_t nr = std::min(NR, nc - jr);
+                    for (std::size_t ir = 0; ir < mc; ir += MR) {
+                        std::size_t mr = std::min(MR, mc - ir);
+                        T* tile = c + static_cast<std::ptrdiff_t>(ic + ir) * rsC + static_cast<std::ptrdiff_t>(jc + jr) * csC;
+                        gemmMicroKernel(kc, packedA.data() + ir * kc, packedB.data() + jr * kc,
+                                        alpha, betaBlock, tile, rsC, csC, mr, nr);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief General matrix multiplication C = alpha * A * B + beta * C
+ * @details A is m x k, B is k x n and C is m x n. Every operand is given by pointer to
+ * the first element plus row and column strides, so transposed operands cost nothing.
+ * When beta is zero C is only written (never read).
+ * Big products are split into 2D tiles of C which run in parallel on getExecutor().
+ *
+ * @tparam T Type of elements
+ */
+template<typename T>
+void gemm(std::size_t m, std::size_t n, std::size_t k, T alpha,
+          const T* a, std::ptrdiff_t rsA, std::ptrdiff_t csA,
+          const T* b, std::ptrdiff_t rsB, std::ptrdiff_t csB,
+          T beta, T* c, std::ptrdiff_t rsC, std::ptrdiff_t csC) {
+    using Blocking = GemmBlocking<T>;
+    constexpr std::size_t MR = Blocking::MR, NR = Blocking::NR;
+
+    std::size_t threads = static_cast<double>(m) * n * k < Blocking::ParallelThreshold ? 1 : getThreadCount();
+    if (threads == 1) {
+        gemmSerial(m, n, k, alpha, a, rsA, csA, b, rsB, csB, beta, c, rsC, csC);
+        return;
+    }
+
+    // Aim for a few tiles per thread so that stealing can even out the load
+    std::size_t tileRows = std::min(Blocking::MC, (m + MR - 1) / MR * MR);
+    std::size_t tileColumns = (n + NR - 1) / NR * NR;
+    auto tiles = [&] { return ((m + tileRows - 1) / tileRows) * ((n + tileColumns - 1) / tileColumns); };
+
+    while (tiles() < 4 * threads && tileColumns > 4 * NR)
+        tileColumns = (tileColumns / 2 + NR - 1) / NR * NR;
+    while (tiles() < 4 * threads && tileRows > 4 * MR)
+        tileRows = (tileRows / 2 + MR - 1) / MR * MR;
+
+    std::size_t rowTiles = (m + tileRows - 1) / tileRows;
+    std::size_t columnTiles = (n + tileColumns - 1) / tileColumns;
+
+    parallelFor(rowTiles * columnTiles, [&](std::size_t tile) {
+        std::size_t i = tile % rowTiles * tileRows, j = tile / rowTiles * tileColumns;
+        std::size_t mc = std::min(tileRows, m - i), nc = std::min(tileColumns, n - j);
+
+        gemmSerial(mc, nc, k, alpha,
+                   a + static_cast<std::ptrdiff_t>(i) * rsA, rsA, csA,
+                   b + static_cast<std::ptrdiff_t>(j) * csB, rsB, csB,
+                   beta, c + static_cast<std::ptrdiff_t>(i) * rsC + static_cast<std::ptrdiff_t>(j) * csC, rsC, csC);
+    });
+}
+
+}
+}
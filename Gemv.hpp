@@ -0,0 +1,86 @@
+/**
+ * @brief Matrix-vector and vector-matrix products
+ *
+ * @file Gemv.hpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include "Allocator.hpp"
+#include "Simd.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace MatrixCpp {
+namespace detail {
+
+/**
+ * @brief Number of elements of the matrix which one task reads
+ * @details Products of vectors are bound by memory bandwidth, so a task only has to be long
+ * enough to amortize scheduling
+ *
+ */
+constexpr std::size_t GemvTaskElements = std::size_t(1) << 15;
+
+/**
+ * @brief Number of columns which one task of vector-matrix product computes
+ * @details The columns of y stay in L1 cache while rows of the matrix stream through
+ *
+ */
+constexpr std::size_t GevmColumns = 1024;
+
+/**
+ * @brief y = A * x for row-major m x n matrix A and contiguous vector x
+ * @details Every element of y is a dot product of a row of A with x, rows are split between threads
+ *
+ * @param strideY Distance between elements of y
+ */
+template<typename T>
+void gemv(std::size_t m, std::size_t n, const T* a, std::size_t strideA, const T* x, T* y, std::size_t strideY) {
+    const ElementwiseKernels<T>& kernels = getElementwiseKernels<T>();
+    const std::size_t rows = std::max<std::size_t>(1, GemvTaskElements / std::max<std::size_t>(n, 1));
+
+    parallelFor((m + rows - 1) / rows, [&](std::size_t chunk) {
+        std::size_t end = std::min(m, (chunk + 1) * rows);
+        for (std::size_t row = chunk * rows; row < end; ++row)
+            y[row * strideY] = kernels.dot(a + row * strideA, x, n);
+    });
+}
+
+/**
+ * @brief y = x * A for contiguous vector x of size m, row-major m x n matrix A and contiguous vector y
+ * @details y accumulates rows of A scaled by elements of x. Tasks take blocks of columns; when there
+ * are fewer blocks than threads the rows are split as well and partial sums are added up at the end.
+ *
+ */
+template<typename T>
+void gevm(std::size_t m, std::size_t n, const T* x, const T* a, std::size_t strideA, T* y) {
+    const ElementwiseKernels<T>& kernels = getElementwiseKernels<T>();
+    const std::size_t blocks = (n + GevmColumns - 1) / GevmColumns;
+    const std::size_t parts = std::max<std::size_t>(1, std::min(getThreadCount() / std::max<std::size_t>(blocks, 1),
+                                                                m * n / GemvTaskElements));
+    const std::size_t rows = (m + parts - 1) / parts;
+
+    // Part 0 accumulates right into y, the others into partial
+    ScratchBuffer<T> partial(parts > 1 ? (parts - 1) * n : 0);
+
+    parallelFor(parts * blocks, [&](std::size_t task) {
+        std::size_t part = task / blocks, begin = (task % blocks) * GevmColumns;
+        std::size_t columns = std::min(GevmColumns, n - begin), end = std::min(m, (part + 1) * rows);
+        T* result = (part == 0 ? y : partial.data() + (part - 1) * n) + begin;
+
+        std::fill_n(result, columns, T());
+        for (std::size_t row = part * rows; row < end; ++row)
+            kernels.axpy(result, x[row], a + row * strideA + begin, columns);
+    });
+
+    for (std::size_t part = 1; part < parts; ++part)
+        kernels.add(y, partial.data() + (part - 1) * n, n);
+}
+
+}
+}
@@ -0,0 +1,294 @@
+/**
+ * @brief Optional counters, timers and trace of library's operations
+ *
+ * @file Instrumentation.hpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ *
+ * Operations are recorded only when MATRIXCPP_INSTRUMENTATION is defined (for the whole program,
+ * e.g. by CMake option of the same name), otherwise the hooks expand to nothing.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace MatrixCpp {
+
+/**
+ * @brief Operations which are counted by instrumentation
+ *
+ */
+enum class InstrumentedOperation {
+    Allocation,
+    Evaluate,
+    Assign,
+    AddAssign,
+    SubtractAssign,
+    MultiplyAssign,
+    ScaleAssign,
+    Multiply,
+    Compare,
+    Transpose,
+    Square,
+    Power,
+    LUDecompose,
+    LUSolve,
+    CholeskyDecompose,
+    CholeskySolve,
+    QRDecompose,
+    QRSolve,
+    Determinant,
+    Count
+};
+
+/**
+ * @brief Totals of one operation since start or last resetInstrumentation()
+ * @details Statistics are inclusive: work of nested operations (e.g. LUDecompose inside Determinant,
+ * Multiply inside Square) counts in both. Allocations outside of any operation (constructors
+ * of matrices) are counted as Allocation.
+ *
+ */
+struct OperationStatistics {
+    InstrumentedOperation operation;
+    const char* name;
+    std::uint64_t calls;
+    std::uint64_t flops;
+    std::uint64_t bytesAllocated;
+    std::uint64_t nanoseconds;
+};
+
+namespace detail {
+
+/**
+ * @brief Trace keeps at most this many events, later ones are dropped
+ *
+ */
+constexpr std::size_t MaxTraceEvents = std::size_t(1) << 20;
+
+inline const char* getOperationName(InstrumentedOperation operation) {
+    static const char* const names[] = {
+        "allocation", "evaluate", "assign", "add_assign", "subtract_assign", "multiply_assign", "scale_assign",
+        "multiply", "compare", "transpose", "square", "power", "lu_decompose", "lu_solve",
+        "cholesky_decompose", "cholesky_solve", "qr_decompose", "qr_solve", "determinant"
+    };
+    return names[static_cast<std::size_t>(operation)];
+}
+
+struct TraceEvent {
+    InstrumentedOperation operation;
+    std::size_t thread;
+    std::uint64_t start;
+    std::uint64_t duration;
+    std::uint64_t flops;
+    std::uint64_t bytesAllocated;
+};
+
+struct OperationCounters {
+    std::atomic<std::uint64_t> calls{0};
+    std::atomic<std::uint64_t> flops{0};
+    std::atomic<std::uint64_t> bytesAllocated{0};
+    std::atomic<std::uint64_t> nanoseconds{0};
+};
+
+struct InstrumentationRegistry {
+    OperationCounters counters[static_cast<std::size_t>(InstrumentedOperation::Count)];
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    std::atomic<bool> tracing{false};
+    std::atomic<std::size_t> threads{0};
+    std::mutex mutex;
+    std::vector<TraceEvent> events;
+};
+
+inline InstrumentationRegistry& getInstrumentationRegistry() {
+    static InstrumentationRegistry registry;
+    return registry;
+}
+
+/**
+ * @brief Records one call of operation from construction to destruction
+ *
+ */
+class ScopedOperation {
+public:
+    ScopedOperation(InstrumentedOperation operation, std::uint64_t flops)
+        : mOperation(operation), mFlops(flops), mBytesAllocated(0), mParent(getCurrent()),
+          mStart(std::chrono::steady_clock::now()) {
+        getCurrent() = this;
+    }
+
+    ~ScopedOperation() {
+        auto end = std::chrono::steady_clock::now();
+        getCurrent() = mParent;
+
+        if (mParent != nullptr) {
+            mParent->mFlops += mFlops;
+            mParent->mBytesAllocated += mBytesAllocated;
+        }
+
+        InstrumentationRegistry& registry = getInstrumentationRegistry();
+        std::uint64_t duration = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - mStart).count());
+
+        OperationCounters& counters = registry.counters[static_cast<std::size_t>(mOperation)];
+        counters.calls.fetch_add(1, std::memory_order_relaxed);
+        counters.flops.fetch_add(mFlops, std::memory_order_relaxed);
+        counters.bytesAllocated.fetch_add(mBytesAllocated, std::memory_order_relaxed);
+        counters.nanoseconds.fetch_add(duration, std::memory_order_relaxed);
+
+        if (registry.tracing.load(std::memory_order_relaxed)) {
+            std::uint64_t start = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(mStart - registry.epoch).count());
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            if (registry.events.size() < MaxTraceEvents)
+                registry.events.push_back(TraceEvent{mOperation, getThreadIndex(), start, duration, mFlops, mBytesAllocated});
+        }
+    }
+
+    ScopedOperation(const ScopedOperation&) = delete;
+    ScopedOperation& operator=(const ScopedOperation&) = delete;
+
+    /**
+     * @brief Attribute allocation to the current operations of this thread
+     *
+     * @param bytes Size of allocation
+     */
+    static void recordAllocation(std::size_t bytes) {
+        if (getCurrent() != nullptr) {
+            getCurrent()->mBytesAllocated += bytes;
+            return;
+        }
+
+        OperationCounters& counters = getInstrumentationRegistry().counters[static_cast<std::size_t>(InstrumentedOperation::Allocation)];
+        counters.calls.fetch_add(1, std::memory_order_relaxed);
+        counters.bytesAllocated.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+private:
+    static ScopedOperation*& getCurrent() {
+        static thread_local ScopedOperation* current = nullptr;
+        return current;
+    }
+
+    static std::size_t getThreadIndex() {
+        static thread_local std::size_t index = getInstrumentationRegistry().threads.fetch_add(1);
+        return index;
+    }
+
+    InstrumentedOperation mOperation;
+    std::uint64_t mFlops;
+    std::uint64_t mBytesAllocated;
+    ScopedOperation* mParent;
+    std::chrono::steady_clock::time_point mStart;
+};
+
+}
+
+/**
+ * @brief Is instrumentation compiled in
+ *
+ * @return bool Whether MATRIXCPP_INSTRUMENTATION is defined
+ */
+constexpr bool isInstrumentationEnabled() {
+#ifdef MATRIXCPP_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Get totals of every operation
+ *
+ * @return std::vector<OperationStatistics> Statistics (all zeros if instrumentation isn't compiled in)
+ */
+inline std::vector<OperationStatistics> getInstrumentationSnapshot() {
+    detail::InstrumentationRegistry& registry = detail::getInstrumentationRegistry();
+    std::vector<OperationStatistics> snapshot;
+
+    for (std::size_t i = 0; i < static_cast<std::size_t>(InstrumentedOperation::Count); ++i) {
+        const detail::OperationCounters& counters = registry.counters[i];
+        InstrumentedOperation operation = static_cast<InstrumentedOperation>(i);
+        snapshot.push_back(OperationStatistics{
+            operation, detail::getOperationName(operation),
+            counters.calls.load(std::memory_order_relaxed), counters.flops.load(std::memory_order_relaxed),
+            counters.bytesAllocated.load(std::memory_order_relaxed), counters.nanoseconds.load(std::memory_order_relaxed)
+        });
+    }
+
+    return snapshot;
+}
+
+/**
+ * @brief Set all counters to zero and clear the trace
+ *
+ */
+inline void resetInstrumentation() {
+    detail::InstrumentationRegistry& registry = detail::getInstrumentationRegistry();
+
+    for (detail::OperationCounters& counters : registry.counters) {
+        counters.calls.store(0, std::memory_order_relaxed);
+        counters.flops.store(0, std::memory_order_relaxed);
+        counters.bytesAllocated.store(0, std::memory_order_relaxed);
+        counters.nanoseconds.store(0, std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.events.clear();
+}
+
+/**
+ * @brief Start or stop recording every call into the trace (off by default)
+ *
+ * @param enabled Record calls
+ */
+inline void setTracing(bool enabled) {
+    detail::getInstrumentationRegistry().tracing.store(enabled);
+}
+
+/**
+ * @brief Write recorded calls in Chrome trace event format (open in chrome://tracing or Perfetto)
+ *
+ * @param path Path to JSON file
+ * @return bool Whether the file was written
+ */
+inline bool writeTrace(const std::string& path) {
+    detail::InstrumentationRegistry& registry = detail::getInstrumentationRegistry();
+
+    std::ofstream file(path);
+    if (!file)
+        return false;
+
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    file << "{\"traceEvents\": [";
+    file.precision(3);
+    file << std::fixed;
+    for (std::size_t i = 0; i < registry.events.size(); ++i) {
+        const detail::TraceEvent& event = registry.events[i];
+        file << (i ? ",\n" : "\n")
+             << "{\"name\": \"" << detail::getOperationName(event.operation) << "\", \"cat\": \"matrixcpp\", \"ph\": \"X\""
+             << ", \"ts\": " << event.start / 1000.0 << ", \"dur\": " << event.duration / 1000.0
+             << ", \"pid\": 0, \"tid\": " << event.thread
+             << ", \"args\": {\"flops\": " << event.flops << ", \"bytes_allocated\": " << event.bytesAllocated << "}}";
+    }
+    file << "\n], \"displayTimeUnit\": \"ns\"}\n";
+
+    return static_cast<bool>(file);
+}
+
+}
+
+#ifdef MATRIXCPP_INSTRUMENTATION
+#define MATRIXCPP_INSTRUMENT(operation, flops) \
+    ::MatrixCpp::detail::ScopedOperation matrixcppScopedOperation(::MatrixCpp::InstrumentedOperation::operation, static_cast<std::uint64_t>(flops))
+#define MATRIXCPP_RECORD_ALLOCATION(bytes) ::MatrixCpp::detail::ScopedOperation::recordAllocation(bytes)
+#else
+#define MATRIXCPP_INSTRUMENT(operation, flops) ((void)0)
+#define MATRIXCPP_RECORD_ALLOCATION(bytes) ((void)0)
+#endif
@@ -9,11 +9,227 @@
 #pragma once
 
 #include "Matrix.hpp"
+#include "Allocator.hpp"
+#include "Gemm.hpp"
+#include "Triangular.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
 
 namespace MatrixCpp {
 
+namespace detail {
+
+/**
+ * @brief Size of square tiles of the task-parallel LU (panels are one tile wide)
+ * 
+ */
+constexpr std::size_t LUBlock = 128;
+
+/**
+ * @brief Panels up to this width are factored column by column
+ * 
+ */
+constexpr std::size_t LUPanelBlock = 8;
+
+template<typename T>
+T magnitude(const T& value) {
+    return value < T() ? -value : value;
+}
+
+/**
+ * @brief Factors columns [begin, begin + width) of rows x columns panel with partial pivoting
+ * @details Halves the panel recursively, so even inside the panel most of the work is GEMM.
+ * Pivoting swaps rows only inside the panel (including already factored columns on the left
+ * and not yet updated columns on the right), the rest of the matrix is left to the caller.
+ * 
+ * @param pivots pivots[k] is the row of the panel which was swapped with row k
+ * @return int Sign of applied row permutation
+ */
+template<typename T>
+int luFactorizePanel(std::size_t rows, std::size_t columns, T* a, std::size_t stride,
+                     std::size_t begin, std::size_t width, std::size_t* pivots) {
+    int sign = 1;
+
+    if (width <= LUPanelBlock) {
+        std::size_t end = begin + width;
+
+        for (std::size_t k = begin; k < end; ++k) {
+            std::size_t pivot = k;
+            T largest = magnitude(a[k * stride + k]);
+            for (std::size_t row = k + 1; row < rows; ++row) {
+                T value = magnitude(a[row * stride + k]);
+                if (largest < value) {
+                    largest = value;
+                    pivot = row;
+                }
+            }
+
+            pivots[k] = pivot;
+            if (pivot != k) {
+                std::swap_ranges(a + k * stride, a + k * stride + columns, a + pivot * stride);
+                sign = -sign;
+            }
+
+            // Whole column is zero: matrix is singular, nothing to eliminate
+            const T diagonal = a[k * stride + k];
+            if (diagonal == T())
+                continue;
+
+            const T* pivotRow = a + k * stride;
+            for (std::size_t row = k + 1; row < rows; ++row) {
+                T* current = a + row * stride;
+                current[k] /= diagonal;
+                const T factor = current[k];
+                for (std::size_t column = k + 1; column < end; ++column)
+                    current[column] -= factor * pivotRow[column];
+            }
+        }
+
+        return sign;
+    }
+
+    std::size_t half = width / 2;
+    sign *= luFactorizePanel(rows, columns, a, stride, begin, half, pivots);
+
+    std::size_t right = begin + half;
+    const std::ptrdiff_t rs = static_cast<std::ptrdiff_t>(stride);
+
+    solveLowerTriangular(true, half, width - half, a + begin * stride + begin, stride, a + begin * stride + right, stride);
+    gemm(rows - right, width - half, half, T(-1),
+         a + right * stride + begin, rs, 1,
+         a + begin * stride + right, rs, 1,
+         T(1), a + right * stride + right, rs, 1);
+
+    sign *= luFactorizePanel(rows, columns, a, stride, right, width - half, pivots);
+
+    return sign;
+}
+
+/**
+ * @brief Applies row swaps of a panel (see luFactorizePanel) in order to other columns
+ * 
+ * @param count Number of swaps
+ * @param columns Number of columns to swap
+ */
+template<typename T>
+void luSwapRows(std::size_t count, const std::size_t* pivots, T* a, std::size_t stride, std::size_t columns) {
+    for (std::size_t k = 0; k < count; ++k)
+        if (pivots[k] != k)
+            std::swap_ranges(a + k * stride, a + k * stride + columns, a + pivots[k] * stride);
+}
+
+/**
+ * @brief Right-hand sides are split into chunks of this many columns which are solved in parallel
+ * 
+ */
+constexpr std::size_t LUSolveColumns = 256;
+
+/**
+ * @brief Tiled LU with partial pivoting scheduled as a task graph: P * A = L * U
+ * @details L (unit diagonal, not stored) and U overwrite A. For every column of tiles k there are tasks
+ * for the panel (tiles k.. of the column, pivoting inside it), for every column j > k the swaps plus
+ * triangular solve of tile (k, j), and for every tile (i, j) below it the GEMM update. A task starts as soon
+ * as the tiles it reads are ready, and tasks closer to the next panel go first, so panel k + 1 is factored
+ * while the rest of the update of step k is still running (lookahead). Swaps of later panels are applied
+ * to the columns of L at the end.
+ * 
+ * @param size Size of A
+ * @param a Pointer to A
+ * @param stride Distance between rows of A
+ * @param permutation permutation[i] is the row of A which became row i (size elements)
+ * @return int Sign of permutation (+1 or -1)
+ */
+template<typename T>
+int luFactorize(std::size_t size, T* a, std::size_t stride, std::size_t* permutation) {
+    std::iota(permutation, permutation + size, std::size_t(0));
+
+    if (size == 0)
+        return 1;
+
+    const std::size_t blocks = (size + LUBlock - 1) / LUBlock;
+    const std::ptrdiff_t rs = static_cast<std::ptrdiff_t>(stride);
+    auto extent = [&](std::size_t block) { return std::min(LUBlock, size - block * LUBlock); };
+    auto tile = [&](std::size_t row, std::size_t column) { return a + (row * stride + column) * LUBlock; };
+
+    // Pivots of panel k are rows relative to its first row k * LUBlock
+    ScratchBuffer<std::size_t> pivots(size);
+    std::vector<int> signs(blocks, 1);
+
+    TaskGraph graph;
+
+    // Last task which writes tile (i, j) before step k reads it
+    const std::size_t none = static_cast<std::size_t>(-1);
+    std::vector<std::size_t> last(blocks * blocks, none);
+    auto after = [&](std::size_t task, std::size_t i, std::size_t j) {
+        if (last[i * blocks + j] != none)
+            graph.precede(last[i * blocks + j], task);
+    };
+
+    for (std::size_t k = 0; k < blocks; ++k) {
+        const std::size_t width = extent(k), first = k * LUBlock;
+
+        std::size_t panel = graph.add([&, k, width, first] {
+            signs[k] = luFactorizePanel(size - first, width, tile(k, k), stride, 0, width, pivots.data() + first);
+        }, blocks - k);
+        for (std::size_t i = k; i < blocks; ++i) {
+            after(panel, i, k);
+            last[i * blocks + k] = panel;
+        }
+
+        for (std::size_t j = k + 1; j < blocks; ++j) {
+            std::size_t solve = graph.add([&, k, j, width, first] {
+                luSwapRows(width, pivots.data() + first, tile(k, j), stride, extent(j));
+                solveLowerTriangular(true, width, extent(j), tile(k, k), stride, tile(k, j), stride);
+            }, blocks - j);
+            graph.precede(panel, solve);
+            for (std::size_t i = k; i < blocks; ++i)
+                after(solve, i, j);
+            last[k * blocks + j] = solve;
+
+            for (std::size_t i = k + 1; i < blocks; ++i) {
+                std::size_t update = graph.add([&, i, j, k, width] {
+                    gemmSerial(extent(i), extent(j), width, T(-1),
+                               tile(i, k), rs, 1,
+                               tile(k, j), rs, 1,
+                               T(1), tile(i, j), rs, 1);
+                }, blocks - j);
+                graph.precede(solve, update);
+                last[i * blocks + j] = update;
+            }
+        }
+    }
+
+    graph.run();
+
+    // Columns of L still miss the swaps of panels right of them
+    parallelFor(blocks - 1, [&](std::size_t j) {
+        for (std::size_t k = j + 1; k < blocks; ++k)
+            luSwapRows(extent(k), pivots.data() + k * LUBlock, tile(k, j), stride, extent(j));
+    });
+
+    int sign = 1;
+    for (std::size_t k = 0; k < blocks; ++k) {
+        sign *= signs[k];
+        for (std::size_t i = k * LUBlock; i < k * LUBlock + extent(k); ++i)
+            std::swap(permutation[i], permutation[k * LUBlock + pivots[i]]);
+    }
+
+    return sign;
+}
+
+}
+
 /**
  * @brief Class to work with decomposition of matrix
+ * @details Computes P * A = L * U with partial pivoting. L and U are kept packed in one
+ * matrix (L below the diagonal, its unit diagonal isn't stored, U on and above it)
+ * together with the permutation of rows.
  * 
  * @tparam Type of square matrice's elements
  */
@@ -33,6 +249,14 @@ public:
      */
 	LUDecomposition(const Matrix<T>& matrix);
 
+    /**
+     * @brief Construct a new LUDecomposition object with decomposition of given block or expression
+     * 
+     * @param Matrix expression (e.g. SubMatrixView) to get decomposition
+     */
+    template<typename E>
+    LUDecomposition(const MatrixExpression<E, T>& matrix);
+
     /**
      * @brief Destroy the LUDecomposition object
      * 
@@ -49,23 +273,54 @@ public:
     bool decompose(const Matrix<T>& matrix);
 
     /**
-     * @brief Get shared_ptr to L-matrix of decomposition
+     * @brief Decomposes given block or expression without copying it into a matrix first
+     * 
+     * @param Matrix expression (e.g. SubMatrixView) to get decomposition
+     * @return true if decomposition was successfully gotten
+     * @return false if decomposition wasn't gotten
+     */
+    template<typename E>
+    bool decompose(const MatrixExpression<E, T>& matrix);
+
+    /**
+     * @brief Get shared_ptr to L-matrix of decomposition (unpacked copy, P * A = L * U)
      * 
      * @return std::shared_ptr<Matrix<T>>
      */
     std::shared_ptr<Matrix<T>> getL() const;
 
     /**
-     * @brief Get shared_ptr to U-matrix of decomposition
+     * @brief Get shared_ptr to U-matrix of decomposition (unpacked copy, P * A = L * U)
      * 
-     * @return std::shared_ptr<Matrix<T>> 
+     * @return std::shared_ptr<Matrix<T>>
      */
     std::shared_ptr<Matrix<T>> getU() const;
 
+    /**
+     * @brief Get packed factors: L below the diagonal (unit diagonal isn't stored), U on and above it
+     * 
+     * @return const Matrix<T>& Packed factors
+     */
+    const Matrix<T>& getFactors() const;
+
+    /**
+     * @brief Get permutation of rows: row i of P * A is row permutation[i] of A
+     * 
+     * @return const std::vector<std::size_t>& Permutation
+     */
+    const std::vector<std::size_t>& getPermutation() const;
+
+    /**
+     * @brief Get sign of permutation (determinant of P)
+     * 
+     * @return int +1 or -1
+     */
+    int getPermutationSign() const;
+
     /**
      * @brief Get the size of L and U matrices (Size x Size)
      * 
-     * @return std::size_t 
+     * @return std::size_t
      */
     std::size_t getSize() const;
 
@@ -77,18 +332,72 @@ public:
      */
     bool isEmpty() const;
 
+    /**
+     * @brief Check is decomposed matrix singular (U has zero on the diagonal)
+     * 
+     * @return true if matrix is singular
+     * @return false if matrix isn't singular
+     */
+    bool isSingular() const;
+
+    /**
+     * @brief Solves A * x = b using stored decomposition
+     * 
+     * @param b Right-hand side
+     * @return std::vector<T> Solution (empty if decomposition is empty or singular, or size of b doesn't match)
+     */
+    std::vector<T> solve(const std::vector<T>& b) const;
+
+    /**
+     * @brief Solves A * X = B for all columns of B at once using stored decomposition
+     * @details Triangular solves are blocked, so most of the work is GEMM
+     * 
+     * @param B Right-hand sides (one per column)
+     * @return Matrix<T> Solutions (empty if decomposition is empty or singular, or rows of B don't match)
+     */
+    Matrix<T> solve(const Matrix<T>& B) const;
+
+    /**
+     * @brief Solves A * X = B for block or expression B
+     * 
+     * @param B Right-hand sides (one per column)
+     * @return Matrix<T> Solutions (empty if decomposition is empty or singular, or rows of B don't match)
+     */
+    template<typename E>
+    Matrix<T> solve(const MatrixExpression<E, T>& B) const;
+
+    /**
+     * @brief Get inverse of decomposed matrix
+     * 
+     * @return Matrix<T> Inverse (empty if decomposition is empty or singular)
+     */
+    Matrix<T> inverse() const;
+
 private:
     /**
-     * @brief Shared-ptr to L-matrix of decomposition
+     * @brief Replaces already permuted right-hand sides with solutions
+     * 
+     * @param X Permuted right-hand sides
+     */
+    void solvePermuted(Matrix<T>& X) const;
+
+    /**
+     * @brief Packed L and U
+     * 
+     */
+    Matrix<T> factors;
+
+    /**
+     * @brief Permutation of rows
      * 
      */
-	std::shared_ptr<Matrix<T>> L;
+    std::vector<std::size_t> permutation;
 
     /**
-     * @brief Shared-ptr to U-matrix of decomposition
+     * @brief Sign of permutation
      * 
      */
-	std::shared_ptr<Matrix<T>> U;
+    int permutationSign;
 
     /**
      * @brief Size of the matrix (as matrix is square, this size is rows' size and columns' size)
@@ -107,6 +416,7 @@ template<typename T>
 LUDecomposition<T>::LUDecomposition() {
     empty = true;
     size = 0;
+    permutationSign = 1;
 }
 
 template<typename T>
@@ -114,6 +424,12 @@ LUDecomposition<T>::LUDecomposition(const Matrix<T>& matrix) {
     decompose(matrix);
 }
 
+template<typename T>
+template<typename E>
+LUDecomposition<T>::LUDecomposition(const MatrixExpression<E, T>& matrix) {
+    decompose(matrix);
+}
+
 template<typename T>
 LUDecomposition<T>::~LUDecomposition() {
 
@@ -121,62 +437,79 @@ LUDecomposition<T>::~LUDecomposition() {
 
 template<typename T>
 bool LUDecomposition<T>::decompose(const Matrix<T>& matrix) {
-    if (!matrix.isSquare()) {
+    return decompose(static_cast<const MatrixExpression<Matrix<T>, T>&>(matrix));
+}
+
+template<typename T>
+template<typename E>
+bool LUDecomposition<T>::decompose(const MatrixExpression<E, T>& expression) {
+    const E& matrix = expression.derived();
+    permutationSign = 1;
+
+    if (matrix.getRows() != matrix.getColumns()) {
         size = 0;
         empty = true;
+        factors = Matrix<T>();
+        permutation.clear();
         return !empty;
     }
 
     size = matrix.getRows();
     empty = false;
 
-    RawMatrix<T> lower = Matrix<T>::allocateRawMatrix(size, size);
-    RawMatrix<T> upper = Matrix<T>::allocateRawMatrix(size, size);
+    MATRIXCPP_INSTRUMENT(LUDecompose, 2.0 / 3.0 * size * size * size);
 
-    for (std::size_t i = 0; i < size; ++i) {
+    factors = matrix;
+    permutation.resize(size);
+    permutationSign = detail::luFactorize(size, factors.getData(), factors.getStride(), permutation.data());
 
-        // Upper Triangular
-        for (std::size_t k = i; k < size; ++k) {
+    return !empty;
+}
 
-            // Summation of L(i, j) * U(j, k)
-            int sum = 0;
-            for (std::size_t j = 0; j < i; ++j)
-                sum += (lower[i][j] * upper[j][k]);
+template<typename T>
+std::shared_ptr<Matrix<T>> LUDecomposition<T>::getL() const {
+    if (empty)
+        return nullptr;
 
-            // Evaluating U(i, k)
-            upper[i][k] = matrix.get(i, k) - sum;
-        }
+    std::shared_ptr<Matrix<T>> lower = std::make_shared<Matrix<T>>(size, size);
 
-        // Lower Triangular
-        for (std::size_t k = i; k < size; ++k) {
-            if (i == k)
-                lower[i][i] = 1; // Diagonal as 1
-            else {
-                // Summation of L(k, j) * U(j, i)
-                int sum = 0;
-                for (size_t j = 0; j < i; ++j)
-                    sum += (lower[k][j] * upper[j][i]);
-
-                // Evaluating L(k, i)
-                lower[k][i] = (matrix.get(k, i) - sum) / upper[i][i];
-            }
-        }
+    for (std::size_t row = 0; row < size; ++row) {
+        T* data = lower->getData() + row * lower->getStride();
+        std::copy_n(factors.getData() + row * factors.getStride(), row, data);
+        data[row] = T(1);
     }
 
-    L = std::make_shared<Matrix<T>>(lower);
-    U = std::make_shared<Matrix<T>>(upper);
+    return lower;
+}
 
-    return !empty;
+template<typename T>
+std::shared_ptr<Matrix<T>> LUDecomposition<T>::getU() const {
+    if (empty)
+        return nullptr;
+
+    std::shared_ptr<Matrix<T>> upper = std::make_shared<Matrix<T>>(size, size);
+
+    for (std::size_t row = 0; row < size; ++row) {
+        const T* source = factors.getData() + row * factors.getStride();
+        std::copy(source + row, source + size, upper->getData() + row * upper->getStride() + row);
+    }
+
+    return upper;
 }
 
 template<typename T>
-std::shared_ptr<Matrix<T>> LUDecomposition<T>::getL() const {
-    return L;
+const Matrix<T>& LUDecomposition<T>::getFactors() const {
+    return factors;
 }
 
 template<typename T>
-std::shared_ptr<Matrix<T>> LUDecomposition<T>::getU() const {
-    return U;
+const std::vector<std::size_t>& LUDecomposition<T>::getPermutation() const {
+    return permutation;
+}
+
+template<typename T>
+int LUDecomposition<T>::getPermutationSign() const {
+    return permutationSign;
 }
 
 template<typename T>
@@ -189,4 +522,101 @@ bool LUDecomposition<T>::isEmpty() const {
     return empty;
 }
 
+template<typename T>
+bool LUDecomposition<T>::isSingular() const {
+    if (empty)
+        return false;
+
+    for (std::size_t i = 0; i < size; ++i)
+        if (factors.getData()[i * factors.getStride() + i] == T())
+            return true;
+
+    return false;
+}
+
+template<typename T>
+std::vector<T> LUDecomposition<T>::solve(const std::vector<T>& b) const {
+    if (empty || b.size() != size || isSingular())
+        return std::vector<T>();
+
+    MATRIXCPP_INSTRUMENT(LUSolve, 2.0 * size * size);
+
+    std::vector<T> x(size);
+    for (std::size_t i = 0; i < size; ++i)
+        x[i] = b[permutation[i]];
+
+    detail::solveLowerTriangular(true, size, 1, factors.getData(), factors.getStride(), x.data(), 1);
+    detail::solveUpperTriangular(false, size, 1, factors.getData(), factors.getStride(), x.data(), 1);
+
+    return x;
+}
+
+template<typename T>
+Matrix<T> LUDecomposition<T>::solve(const Matrix<T>& B) const {
+    if (empty || B.getRows() != size || isSingular())
+        return Matrix<T>();
+
+    MATRIXCPP_INSTRUMENT(LUSolve, 2.0 * size * size * B.getColumns());
+
+    Matrix<T> X(size, B.getColumns());
+    for (std::size_t i = 0; i < size; ++i)
+        std::copy_n(B.getData() + permutation[i] * B.getStride(), B.getColumns(), X.getData() + i * X.getStride());
+
+    solvePermuted(X);
+
+    return X;
+}
+
+template<typename T>
+template<typename E>
+Matrix<T> LUDecomposition<T>::solve(const MatrixExpression<E, T>& expression) const {
+    const E& B = expression.derived();
+
+    if (empty || B.getRows() != size || isSingular())
+        return Matrix<T>();
+
+    MATRIXCPP_INSTRUMENT(LUSolve, 2.0 * size * size * B.getColumns());
+
+    Matrix<T> X(size, B.getColumns());
+    for (std::size_t i = 0; i < size; ++i)
+        for (std::size_t column = 0; column < B.getColumns(); ++column)
+            X.getData()[i * X.getStride() + column] = B.get(permutation[i], column);
+
+    solvePermuted(X);
+
+    return X;
+}
+
+template<typename T>
+Matrix<T> LUDecomposition<T>::inverse() const {
+    if (empty || isSingular())
+        return Matrix<T>();
+
+    MATRIXCPP_INSTRUMENT(LUSolve, 2.0 * size * size * size);
+
+    // P * I: row i has its one in column permutation[i]
+    Matrix<T> X(size, size);
+    for (std::size_t i = 0; i < size; ++i)
+        X.getData()[i * X.getStride() + permutation[i]] = T(1);
+
+    solvePermuted(X);
+
+    return X;
+}
+
+template<typename T>
+void LUDecomposition<T>::solvePermuted(Matrix<T>& X) const {
+    std::size_t columns = X.getColumns();
+    std::size_t chunks = (columns + detail::LUSolveColumns - 1) / detail::LUSolveColumns;
+
+    parallelFor(chunks, [&](std::size_t chunk) {
+        std::size_t begin = chunk * detail::LUSolveColumns;
+        std::size_t width = std::min(detail::LUSolveColumns, columns - begin);
+        T* data = X.getData() + begin;
+
+        detail::solveLowerTriangular(true, size, width, factors.getData(), factors.getStride(), data, X.getStride());
+        detail::solveUpperTriangular(false, size, width, factors.getData(), factors.getStride(), data, X.getStride());
+    });
+}
+
 }
\ No newline at end of file
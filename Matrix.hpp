@@ -8,28 +8,127 @@
 
 #pragma once
 
+#include "Allocator.hpp"
+#include "Gemm.hpp"
+#include "Instrumentation.hpp"
+#include "Transpose.hpp"
+#include "Triangular.hpp"
+#include "MatrixExpression.hpp"
+#include "MatrixFile.hpp"
+#include "MatrixView.hpp"
+#include "Multiply.hpp"
+#include "Simd.hpp"
+#include "Strassen.hpp"
+
 #include <cstdlib>
+#include <cstddef>
 #include <string>
 #include <iostream>
 #include <vector>
 #include <tuple>
+#include <new>
+#include <memory>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
 
 namespace MatrixCpp {
 
 template<typename T>
 using RawMatrix = std::vector<std::vector<T>>;
 
-template <typename T>
-class Matrix {
+/**
+ * @brief Read-only view of matrix which looks like RawMatrix
+ * @details Iterates over rows as RowView and converts to RawMatrix on demand
+ * 
+ * @tparam T Type of elements
+ */
+template<typename T>
+class RawMatrixView {
 public:
+	class iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = RowView<const T>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = RowView<const T>;
+
+		iterator(const T* data, std::size_t columns, std::size_t stride)
+			: mData(data), mColumns(columns), mStride(stride) {}
+
+		RowView<const T> operator*() const { return RowView<const T>(mData, mColumns); }
+		iterator& operator++() { mData += mStride; return *this; }
+		iterator operator++(int) { iterator it = *this; mData += mStride; return it; }
+		bool operator==(const iterator& rhs) const { return mData == rhs.mData; }
+		bool operator!=(const iterator& rhs) const { return mData != rhs.mData; }
+
+	private:
+		const T* mData;
+		std::size_t mColumns;
+		std::size_t mStride;
+	};
+
+	RawMatrixView(const T* data, std::size_t rows, std::size_t columns, std::size_t stride)
+		: mData(data), mRows(rows), mColumns(columns), mStride(stride) {}
+
+	/**
+	 * @brief Get number of rows
+	 * 
+	 * @return std::size_t Number of rows
+	 */
+	std::size_t size() const { return mRows; }
+
+	RowView<const T> operator[](std::size_t row) const {
+		return RowView<const T>(mData + row * mStride, mColumns);
+	}
+
+	iterator begin() const { return iterator(mData, mColumns, mStride); }
+	iterator end() const { return iterator(mData + mRows * mStride, mColumns, mStride); }
+
+	/**
+	 * @brief Materializes the view into RawMatrix
+	 * 
+	 * @return RawMatrix<T> Copy of elements
+	 */
+	operator RawMatrix<T>() const {
+		RawMatrix<T> rawMatrix(mRows);
+		for (std::size_t row = 0; row < mRows; ++row)
+			rawMatrix[row].assign(mData + row * mStride, mData + row * mStride + mColumns);
+		return rawMatrix;
+	}
+
+private:
+	const T* mData;
+	std::size_t mRows;
+	std::size_t mColumns;
+	std::size_t mStride;
+};
+
+/**
+ * @brief Dense matrix with row-major contiguous storage
+ * 
+ * @tparam T Type of elements
+ * @tparam Allocator Allocator of storage (AlignedAllocator by default)
+ */
+template <typename T, typename Allocator>
+class Matrix : public MatrixExpression<Matrix<T, Allocator>, T> {
+public:
+	/**
+	 * @brief Allocator of the storage of matrix
+	 * 
+	 */
+	using AllocatorType = Allocator;
+
 	/**
 	 * @brief Construct a new Matrix object
 	 * 
 	 * @param rows Number of rows of matrix
 	 * @param columns Number of columns of matrix
 	 * @param defaultValue Default value to initialize elements of matrix
+	 * @param allocator Allocator of storage
 	 */
-	Matrix(std::size_t rows = 0, std::size_t columns = 0, T defaultValue = T());
+	Matrix(std::size_t rows = 0, std::size_t columns = 0, T defaultValue = T(), const Allocator& allocator = Allocator());
 	/**
 	 * @brief Construct a new Matrix object from RawMatrix
 	 * 
@@ -49,21 +148,92 @@ public:
 	 * 
 	 * @param matrix Matrix to copy
 	 */
-	Matrix(const Matrix<T>& matrix);
+	Matrix(const Matrix<T, Allocator>& matrix);
+
+	/**
+	 * @brief Move constructor (takes storage of other matrix, leaves it empty)
+	 * 
+	 * @param matrix Matrix to move
+	 */
+	Matrix(Matrix<T, Allocator>&& matrix) noexcept;
+
+	/**
+	 * @brief Construct a new Matrix object by evaluating an expression (in one pass)
+	 * 
+	 * @param expression Expression, e.g. `a + b * 2`
+	 */
+	template<typename E>
+	Matrix(const MatrixExpression<E, T>& expression);
 
 	/**
 	 * @brief Destroy the Matrix object
 	 * 
 	 */
 	~Matrix();
-	
+
+	/**
+	 * @brief Copy assignment
+	 * 
+	 * @param matrix Matrix to copy
+	 * @return Matrix<T>& This matrix
+	 */
+	Matrix<T, Allocator>& operator=(const Matrix<T, Allocator>& matrix);
+
+	/**
+	 * @brief Move assignment (takes storage of other matrix, leaves it empty)
+	 * 
+	 * @param matrix Matrix to move
+	 * @return Matrix<T>& This matrix
+	 */
+	Matrix<T, Allocator>& operator=(Matrix<T, Allocator>&& matrix) noexcept;
+
+	/**
+	 * @brief Swaps contents of two matrices without copying elements
+	 * 
+	 * @param matrix Other matrix
+	 */
+	void swap(Matrix<T, Allocator>& matrix) noexcept;
+
+	/**
+	 * @brief Evaluates an expression into the matrix (in one pass, without temporaries)
+	 * 
+	 * @param expression Expression, e.g. `a + b * 2`
+	 * @return Matrix<T>& This matrix
+	 */
+	template<typename E>
+	Matrix<T, Allocator>& operator=(const MatrixExpression<E, T>& expression);
+
 	/**
 	 * @brief Get the RawMatrix of matrix
+	 * @details Returns a view over the contiguous storage. It converts to RawMatrix<T>
+	 * (with copying) for code which needs real std::vector's
+	 * 
+	 * @return RawMatrixView<T> View of matrix
+	 */
+	RawMatrixView<T> getRawMatrix() const;
+
+	/**
+	 * @brief Get pointer to the storage of matrix
+	 * @details Elements are stored row by row, row `r` starts at `getData() + r * getStride()`
+	 * 
+	 * @return T* Pointer to the first element
+	 */
+	T* getData();
+
+	/**
+	 * @brief Get pointer to the storage of matrix (read only)
 	 * 
-	 * @return const RawMatrix<T>& RawMatrix of matrix
+	 * @return const T* Pointer to the first element
 	 */
-	const RawMatrix<T>& getRawMatrix() const;
-	
+	const T* getData() const;
+
+	/**
+	 * @brief Get the distance (in elements) between starts of two neighbour rows
+	 * 
+	 * @return std::size_t Leading dimension of storage
+	 */
+	std::size_t getStride() const;
+
 	/**
 	 * @brief Get number of rows in matrix
 	 * 
@@ -81,25 +251,63 @@ public:
 	/**
 	 * @brief Get the Diagonal Elements of Matrix
 	 * 
-	 * @return std::vector<T>& Elements
+	 * @return std::vector<T> Elements (empty if matrix isn't square)
 	 */
-	std::vector<T>& getDiagonalElements() const;
+	std::vector<T> getDiagonalElements() const;
 
 	/**
 	 * @brief Get elements of specific row
 	 * 
 	 * @param row Specific row
-	 * @return std::vector<T>& All elements of row
+	 * @return std::vector<T> All elements of row
 	 */
-	std::vector<T>& getRowElements(std::size_t row) const;
+	std::vector<T> getRowElements(std::size_t row) const;
 
 	/**
 	 * @brief Get elements of specific column
 	 * 
 	 * @param column Specific column
-	 * @return std::vector<T>& All elements if column
+	 * @return std::vector<T> All elements if column
 	 */
-	std::vector<T>& getColumnElements(std::size_t column) const;
+	std::vector<T> getColumnElements(std::size_t column) const;
+
+	/**
+	 * @brief Get view of specific row (no copying, writes go to the matrix)
+	 * 
+	 * @param row Specific row
+	 * @return RowView<T> View of row
+	 */
+	RowView<T> getRow(std::size_t row);
+	RowView<const T> getRow(std::size_t row) const;
+
+	/**
+	 * @brief Get view of specific column (no copying, writes go to the matrix)
+	 * 
+	 * @param column Specific column
+	 * @return ColumnView<T> View of column
+	 */
+	ColumnView<T> getColumn(std::size_t column);
+	ColumnView<const T> getColumn(std::size_t column) const;
+
+	/**
+	 * @brief Get view of main diagonal (no copying, writes go to the matrix)
+	 * 
+	 * @return DiagonalView<T> View of diagonal
+	 */
+	DiagonalView<T> getDiagonal();
+	DiagonalView<const T> getDiagonal() const;
+
+	/**
+	 * @brief Get view of block of matrix (no copying, writes go to the matrix)
+	 * 
+	 * @param row Row of top left element of block
+	 * @param column Column of top left element of block
+	 * @param rows Number of rows in block
+	 * @param columns Number of columns in block
+	 * @return SubMatrixView<T> View of block
+	 */
+	SubMatrixView<T> getSubMatrix(std::size_t row, std::size_t column, std::size_t rows, std::size_t columns);
+	SubMatrixView<const T> getSubMatrix(std::size_t row, std::size_t column, std::size_t rows, std::size_t columns) const;
 
 	/**
 	 * @brief Set specific element to some value
@@ -118,7 +326,32 @@ public:
 	 * @return T Value of element
 	 */
 	T get(std::size_t row, std::size_t column) const;
-	
+
+	/**
+	 * @brief Get specific element value without any checks (used by expressions)
+	 * 
+	 * @param row Row of element
+	 * @param column Column of element
+	 * @return T Value of element
+	 */
+	T evaluate(std::size_t row, std::size_t column) const;
+
+	/**
+	 * @brief Matrix as expression is always conformable (used by expressions)
+	 * 
+	 * @return true always
+	 */
+	bool isConformable() const;
+
+	/**
+	 * @brief Checks whether elements of the matrix lie in [begin, end) (used by expressions)
+	 * 
+	 * @param begin Start of memory range
+	 * @param end End of memory range
+	 * @return true if some element lies in the range
+	 */
+	bool overlaps(const T* begin, const T* end) const;
+
 	/**
 	 * @brief Checks: is vector the matrix or not
 	 * 
@@ -145,201 +378,392 @@ public:
 
 	/**
 	 * @brief Transposes the matrix
+	 * @details Square matrices are transposed in place without allocations
 	 * 
 	 */
 	void transpose();
 
+	/**
+	 * @brief Get transposed copy of the matrix
+	 * 
+	 * @return Matrix<T> Transposed matrix
+	 */
+	Matrix<T, Allocator> transposed() const;
+
+	/**
+	 * @brief Writes transposed matrix into destination
+	 * @details Destination is reallocated only if its shape doesn't match,
+	 * so reusing it avoids allocations on hot paths
+	 * 
+	 * @param destination Matrix for the result
+	 */
+	void transposed(Matrix<T, Allocator>& destination) const;
+
 	//T getDeterminant() const;
 
 	/**
 	 * @brief Squares the matrix (matrix ^ 2)
 	 * 
-	 * @return Matrix<T>& Matrix in square
+	 * @return Matrix<T> Matrix in square
+	 */
+	Matrix<T, Allocator> Square() const;
+
+	/**
+	 * @brief Raises the matrix to a power by repeated squaring (O(log exponent) products)
+	 * @details The products alternate between the result and one scratch buffer, so only the
+	 * result is allocated. Diagonal matrices are raised elementwise and products of triangular
+	 * matrices skip their zero halves. If the matrix isn't square, the result is a copy of it.
+	 * 
+	 * @param exponent Power (0 gives the identity matrix)
+	 * @return Matrix<T> Matrix in power
 	 */
-	Matrix<T>& Square();
+	Matrix<T, Allocator> pow(std::size_t exponent) const;
 
 	/**
 	 * @brief Overloading of operator [] to access some row of matrix
 	 * 
 	 * @param row Specific row
-	 * @return std::vector<T>& All elements in this row
+	 * @return RowView<T> All elements in this row
 	 */
-	std::vector<T>& operator[](std::size_t row);
+	RowView<T> operator[](std::size_t row);
 
 	/**
 	 * @brief Overloading of operator [] to access some row of matrix (read only)
 	 * 
 	 * @param row Specific row
-	 * @return const std::vector<T>& All elements in this row
+	 * @return RowView<const T> All elements in this row
 	 */
-	const std::vector<T>& operator[](std::size_t row) const;
+	RowView<const T> operator[](std::size_t row) const;
 
-	Matrix<T>& operator+=(const Matrix<T>& rhs);
-	Matrix<T>& operator-=(const Matrix<T>& rhs);
-	Matrix<T>& operator*=(const Matrix<T>& rhs);
-	Matrix<T>& operator*=(const T& value);
-	Matrix<T>& operator/=(const T& value);
+	Matrix<T, Allocator>& operator+=(const Matrix<T, Allocator>& rhs);
+	Matrix<T, Allocator>& operator-=(const Matrix<T, Allocator>& rhs);
+	Matrix<T, Allocator>& operator*=(const Matrix<T, Allocator>& rhs);
+	Matrix<T, Allocator>& operator*=(const T& value);
+	Matrix<T, Allocator>& operator/=(const T& value);
 
 	/**
-	 * @brief Overloading for operator +
+	 * @brief Adds an expression to the matrix in one pass
 	 * 
-	 * @param lhs Left matrix
-	 * @param rhs Right matrix
-	 * @return Matrix<T> Result
+	 * @param rhs Expression
+	 * @return Matrix<T>& This matrix
 	 */
-	friend Matrix<T> operator+(Matrix<T> lhs, const Matrix<T>& rhs) {
-		return lhs += rhs;
-	}
+	template<typename E>
+	Matrix<T, Allocator>& operator+=(const MatrixExpression<E, T>& rhs);
 
 	/**
-	 * @brief Overloading for operator -
+	 * @brief Subtracts an expression from the matrix in one pass
 	 * 
-	 * @param lhs Left matrix
-	 * @param rhs Right matrix
-	 * @return Matrix<T> Result
+	 * @param rhs Expression
+	 * @return Matrix<T>& This matrix
 	 */
-	friend Matrix<T> operator-(Matrix<T> lhs, const Matrix<T>& rhs) {
-		return lhs -= rhs;
-	}
+	template<typename E>
+	Matrix<T, Allocator>& operator-=(const MatrixExpression<E, T>& rhs);
 
 	/**
-	 * @brief Overloading for operator * (multiplying matrix by matrix)
+	 * @brief Multiplies the matrix by evaluated expression
 	 * 
-	 * @param lhs Left matrix
-	 * @param rhs Right matrix
-	 * @return Matrix<T> Multiplied matrix
+	 * @param rhs Expression
+	 * @return Matrix<T>& This matrix
 	 */
-	friend Matrix<T> operator*(Matrix<T> lhs, const Matrix<T>& rhs) {
-		return lhs *= rhs;
-	}
+	template<typename E>
+	Matrix<T, Allocator>& operator*=(const MatrixExpression<E, T>& rhs);
 
 	/**
-	 * @brief Overloading for operator * (multiplying matrix by number)
+	 * @brief Static method for easy allocating RawMatrix (used just by some algorithms)
 	 * 
-	 * @param lhs Matrix to multiply
-	 * @param rhs Number to multiply
-	 * @return Matrix<T> Multiplied matrix
+	 * @param rows Number of rows od matrix
+	 * @param columns Number of columns of matrix
+	 * @return RawMatrix<T> new RawMatrix
 	 */
-	friend Matrix<T> operator*(Matrix<T> lhs, const T& rhs) {
-		return lhs *= rhs;
-	}
+	static RawMatrix<T> allocateRawMatrix(std::size_t rows, std::size_t columns);
 
 	/**
-	 * @brief Overloading for multiplying of matrix by some value
-	 * @details Multiplies a matrix by some number
+	 * @brief Get allocator of the storage
 	 * 
-	 * @param lhs Value
-	 * @param rhs Matrix
+	 * @return Allocator Allocator
+	 */
+	Allocator getAllocator() const;
+
+	/**
+	 * @brief Maps matrix file into memory without reading it
+	 * @details Pages of the file are read on first access and copied on first write,
+	 * the file itself is never modified. Files written on a machine with other byte order
+	 * are loaded with conversion instead.
 	 * 
-	 * @return Matrix<T> Multiplied matrix
+	 * @param path Path to file written by writeFile()
+	 * @return Matrix<T> Matrix backed by the file (empty if file can't be mapped or holds other type)
 	 */
-	friend Matrix<T> operator*(T lhs, Matrix<T>& rhs) {
-		return rhs *= lhs;
-	}
+	static Matrix<T, Allocator> mapFile(const std::string& path);
 
 	/**
-	 * @brief Multiplies matrix by -1
-	 * @details Multiplies each element of matrix by -1
-	 * @return Matrix<T> Matrix with multiplied by -1 elements
+	 * @brief Writes matrix into binary file which can be mapped by mapFile()
+	 * @details Don't overwrite the file this matrix is mapped from
+	 * 
+	 * @param path Path to file
+	 * @return bool Whether the file was written
 	 */
-	Matrix<T> operator-();
+	bool writeFile(const std::string& path) const;
 
 	/**
-	 * @brief Static method for easy allocating RawMatrix (used just by some algorithms)
+	 * @brief Is storage of matrix a mapped file
 	 * 
-	 * @param rows Number of rows od matrix
-	 * @param columns Number of columns of matrix
-	 * @return RawMatrix<T>& new RawMatrix
+	 * @return bool Is matrix mapped
 	 */
-	static RawMatrix<T>& allocateRawMatrix(std::size_t rows, std::size_t columns);
+	bool isMapped() const;
 
 private:
+	using AllocatorTraits = std::allocator_traits<Allocator>;
+
+	Allocator mAllocator;
 	std::size_t mRows;
 	std::size_t mColumns;
-	RawMatrix<T> mRawMatrix;
+	std::size_t mStride;
+	T* mData;
+	std::shared_ptr<detail::MappedFile> mMapping;
 
 private:
-	RawMatrix<T>* allocRawMatrix(std::size_t width, std::size_t height, T defaultValue = T()) const;
+	/**
+	 * @brief Allocates aligned storage for rows x columns elements and fills it with value
+	 * 
+	 * @param rows Number of rows
+	 * @param columns Number of columns
+	 * @param defaultValue Value to fill storage
+	 */
+	void allocateStorage(std::size_t rows, std::size_t columns, T defaultValue = T());
+
+	/**
+	 * @brief Destroys elements and frees storage
+	 * 
+	 */
+	void freeStorage();
+
+	/**
+	 * @brief Writes values of expression with the same shape into the matrix
+	 * 
+	 * @param expression Expression
+	 * @param operation How to combine old element and element of expression
+	 */
+	template<typename E, typename Operation>
+	void assignExpression(const E& expression, Operation operation);
 };
 
-template<typename T>
-Matrix<T>::Matrix(std::size_t rows, std::size_t columns, T defaultValue) {
-	this->mColumns = columns;
-	this->mRows = rows;
+template<typename T, typename Allocator>
+Matrix<T, Allocator>::Matrix(std::size_t rows, std::size_t columns, T defaultValue, const Allocator& allocator) : mAllocator(allocator) {
+	allocateStorage(rows, columns, defaultValue);
+}
 
-	this->mRawMatrix = *allocRawMatrix(rows, columns, defaultValue);
+template<typename T, typename Allocator>
+Matrix<T, Allocator>::Matrix(const std::initializer_list<std::initializer_list<T>>& rawMatrixList)
+		  :Matrix(rawMatrixList.size(), rawMatrixList.size() ? rawMatrixList.begin()->size() : 0)
+{
+	std::size_t row = 0;
+	for (auto & list : rawMatrixList) {
+		std::copy_n(list.begin(), std::min(list.size(), mColumns), mData + row * mStride);
+		++row;
+	}
 }
 
-template<typename T>
-Matrix<T>::Matrix(const std::initializer_list<std::initializer_list<T>>& rawMatrixList)
-		  :Matrix(rawMatrixList.size(), rawMatrixList.begin()->size())
+template<typename T, typename Allocator>
+Matrix<T, Allocator>::Matrix(const RawMatrix<T>& rawMatrix)
+		  :Matrix(rawMatrix.size(), rawMatrix.empty() ? 0 : rawMatrix[0].size())
 {
-	std::size_t rows = rawMatrixList.size(), columns = rawMatrixList.begin()->size();
-	for (std::size_t r = 0; r < rows; ++r) {
-		for (std::size_t c = 0; c < columns; ++c) {
-			mRawMatrix[r][c] = *((rawMatrixList.begin() + r)->begin() + c);
-		}
+	for (std::size_t row = 0; row < mRows; ++row) {
+		std::copy_n(rawMatrix[row].begin(), std::min(rawMatrix[row].size(), mColumns), mData + row * mStride);
 	}
 }
 
-template<typename T>
-Matrix<T>::Matrix(const RawMatrix<T>& rawMatrix) {
-	mRows = rawMatrix.size();
-	mColumns = rawMatrix[0].size();
-	
-	mRawMatrix = *allocRawMatrix(mRows, mColumns);
-	std::copy(rawMatrix.begin(), rawMatrix.end(), mRawMatrix.begin());
+template<typename T, typename Allocator>
+Matrix<T, Allocator>::Matrix(const Matrix<T, Allocator>& matrix)
+		  :Matrix(matrix.getRows(), matrix.getColumns(), T(), AllocatorTraits::select_on_container_copy_construction(matrix.mAllocator))
+{
+	for (std::size_t row = 0; row < mRows; ++row) {
+		std::copy_n(matrix.getData() + row * matrix.getStride(), mColumns, mData + row * mStride);
+	}
 }
 
-template<typename T>
-Matrix<T>::Matrix(const Matrix<T>& matrix) : Matrix(matrix.getRawMatrix()) 
+template<typename T, typename Allocator>
+Matrix<T, Allocator>::Matrix(Matrix<T, Allocator>&& matrix) noexcept
+		  :mAllocator(std::move(matrix.mAllocator)), mRows(matrix.mRows), mColumns(matrix.mColumns), mStride(matrix.mStride), mData(matrix.mData),
+		   mMapping(std::move(matrix.mMapping))
 {
-	std::cout << "Copying constructor called" << std::endl;
+	matrix.mRows = 0;
+	matrix.mColumns = 0;
+	matrix.mStride = 0;
+	matrix.mData = nullptr;
 }
 
-template<typename T>
-Matrix<T>::~Matrix() 
-{}
+template<typename T, typename Allocator>
+template<typename E>
+Matrix<T, Allocator>::Matrix(const MatrixExpression<E, T>& expression)
+		  :Matrix(expression.derived().getRows(), expression.derived().getColumns())
+{
+	MATRIXCPP_INSTRUMENT(Evaluate, 0);
+	assignExpression(expression.derived(), [](T&, const T& value) { return value; });
+}
 
-template<typename T>
-RawMatrix<T>& Matrix<T>::allocateRawMatrix(std::size_t rows, std::size_t columns) {
-	RawMatrix<T>* matrix = new RawMatrix<T>();
-	matrix->resize(rows);
-	
-	for (auto & row : *matrix) {
-		row.resize(columns);
+template<typename T, typename Allocator>
+Matrix<T, Allocator>::~Matrix()
+{
+	freeStorage();
+}
+
+template<typename T, typename Allocator>
+Matrix<T, Allocator>& Matrix<T, Allocator>::operator=(const Matrix<T, Allocator>& matrix) {
+	if (this == &matrix)
+		return *this;
+
+	MATRIXCPP_INSTRUMENT(Assign, 0);
+
+	if (mRows != matrix.getRows() || mColumns != matrix.getColumns()) {
+		freeStorage();
+		allocateStorage(matrix.getRows(), matrix.getColumns());
 	}
 
-	return *matrix;
+	for (std::size_t row = 0; row < mRows; ++row) {
+		std::copy_n(matrix.getData() + row * matrix.getStride(), mColumns, mData + row * mStride);
+	}
+
+	return *this;
 }
 
-template<typename T>
-const RawMatrix<T>& Matrix<T>::getRawMatrix() const {
-	return mRawMatrix;
+template<typename T, typename Allocator>
+Matrix<T, Allocator>& Matrix<T, Allocator>::operator=(Matrix<T, Allocator>&& matrix) noexcept {
+	if (this != &matrix) {
+		Matrix<T, Allocator> moved(std::move(matrix));
+		swap(moved);
+	}
+
+	return *this;
 }
 
-template<typename T>
-std::size_t Matrix<T>::getRows() const {
+template<typename T, typename Allocator>
+void Matrix<T, Allocator>::swap(Matrix<T, Allocator>& matrix) noexcept {
+	using std::swap;
+	swap(mAllocator, matrix.mAllocator);
+	std::swap(mRows, matrix.mRows);
+	std::swap(mColumns, matrix.mColumns);
+	std::swap(mStride, matrix.mStride);
+	std::swap(mData, matrix.mData);
+	mMapping.swap(matrix.mMapping);
+}
+
+template<typename T, typename Allocator>
+template<typename E>
+Matrix<T, Allocator>& Matrix<T, Allocator>::operator=(const MatrixExpression<E, T>& expression) {
+	MATRIXCPP_INSTRUMENT(Assign, 0);
+	const E& e = expression.derived();
+
+	if (mRows != e.getRows() || mColumns != e.getColumns()) {
+		// Expression may read this matrix, so evaluate it aside
+		Matrix<T, Allocator> matrix(expression);
+		swap(matrix);
+		return *this;
+	}
+
+	// Every element depends only on elements at the same position, so it's safe in place
+	assignExpression(e, [](T&, const T& value) { return value; });
+
+	return *this;
+}
+
+template<typename T, typename Allocator>
+RawMatrix<T> Matrix<T, Allocator>::allocateRawMatrix(std::size_t rows, std::size_t columns) {
+	return RawMatrix<T>(rows, std::vector<T>(columns));
+}
+
+template<typename T, typename Allocator>
+Allocator Matrix<T, Allocator>::getAllocator() const {
+	return mAllocator;
+}
+
+template<typename T, typename Allocator>
+Matrix<T, Allocator> Matrix<T, Allocator>::mapFile(const std::string& path) {
+	detail::MappedMatrix<T> mapped = detail::mapMatrixFile<T>(path);
+	if (!mapped.file)
+		return Matrix<T, Allocator>();
+
+	Matrix<T, Allocator> matrix;
+	if (mapped.swapped || mapped.rows * mapped.columns == 0) {
+		matrix.allocateStorage(mapped.rows, mapped.columns);
+		std::transform(mapped.data, mapped.data + mapped.rows * mapped.columns, matrix.mData, detail::byteSwap<T>);
+		return matrix;
+	}
+
+	matrix.mRows = mapped.rows;
+	matrix.mColumns = mapped.columns;
+	matrix.mStride = mapped.columns;
+	matrix.mData = mapped.data;
+	matrix.mMapping = std::move(mapped.file);
+	return matrix;
+}
+
+template<typename T, typename Allocator>
+bool Matrix<T, Allocator>::writeFile(const std::string& path) const {
+	return detail::writeMatrixFile(path, mData, mRows, mColumns, mStride);
+}
+
+template<typename T, typename Allocator>
+bool Matrix<T, Allocator>::isMapped() const {
+	return mMapping != nullptr;
+}
+
+template<typename T, typename Allocator>
+RawMatrixView<T> Matrix<T, Allocator>::getRawMatrix() const {
+	return RawMatrixView<T>(mData, mRows, mColumns, mStride);
+}
+
+template<typename T, typename Allocator>
+T* Matrix<T, Allocator>::getData() {
+	return mData;
+}
+
+template<typename T, typename Allocator>
+const T* Matrix<T, Allocator>::getData() const {
+	return mData;
+}
+
+template<typename T, typename Allocator>
+std::size_t Matrix<T, Allocator>::getStride() const {
+	return mStride;
+}
+
+template<typename T, typename Allocator>
+std::size_t Matrix<T, Allocator>::getRows() const {
 	return mRows;
 }
 
-template<typename T>
-std::size_t Matrix<T>::getColumns() const {
+template<typename T, typename Allocator>
+std::size_t Matrix<T, Allocator>::getColumns() const {
 	return mColumns;
 }
 
-template<typename T>
-void Matrix<T>::set(std::size_t row, std::size_t column, T value) {
-	mRawMatrix[row][column] = value;
+template<typename T, typename Allocator>
+void Matrix<T, Allocator>::set(std::size_t row, std::size_t column, T value) {
+	mData[row * mStride + column] = value;
 }
 
-template<typename T>
-T Matrix<T>::get(std::size_t row, std::size_t column) const {
-	return mRawMatrix[row][column];
+template<typename T, typename Allocator>
+T Matrix<T, Allocator>::get(std::size_t row, std::size_t column) const {
+	return mData[row * mStride + column];
 }
 
-template<typename T>
-bool Matrix<T>::isVector() const {
+template<typename T, typename Allocator>
+T Matrix<T, Allocator>::evaluate(std::size_t row, std::size_t column) const {
+	return mData[row * mStride + column];
+}
+
+template<typename T, typename Allocator>
+bool Matrix<T, Allocator>::isConformable() const {
+	return true;
+}
+
+template<typename T, typename Allocator>
+bool Matrix<T, Allocator>::overlaps(const T* begin, const T* end) const {
+	return detail::overlapsBlock(static_cast<const T*>(mData), mRows, mColumns, mStride, begin, end);
+}
+
+template<typename T, typename Allocator>
+bool Matrix<T, Allocator>::isVector() const {
 	if (mColumns == 1 && mRows > 1)
 		return true;
 	else if (mRows == 1 && mColumns > 1)
@@ -348,94 +772,237 @@ bool Matrix<T>::isVector() const {
 		return false;
 }
 
-template<typename T>
-bool Matrix<T>::isSquare() const {
+template<typename T, typename Allocator>
+bool Matrix<T, Allocator>::isSquare() const {
 	if (mColumns == mRows)
 		return true;
 	else
 		return false;
 }
 
-template<typename T>
-bool Matrix<T>::isNull() const {
-	for (auto & r : mRawMatrix) {
-		for (auto & el : r) {
-			if (el != 0)
-				return false;
-		}
+template<typename T, typename Allocator>
+bool Matrix<T, Allocator>::isNull() const {
+	const detail::ElementwiseKernels<T>& kernels = detail::getElementwiseKernels<T>();
+	std::size_t rows = mRows, columns = mColumns;
+
+	if (mStride == columns) {
+		columns *= rows;
+		rows = 1;
+	}
+
+	for (std::size_t row = 0; row < rows; ++row) {
+		if (!kernels.isZero(mData + row * mStride, columns))
+			return false;
 	}
 
 	return true;
 }
 
-template<typename T>
-void Matrix<T>::transpose() {
-	std::size_t rows = getColumns(), columns = getRows();
-	RawMatrix<T> transposed = *allocRawMatrix(rows, columns);
+template<typename T, typename Allocator>
+void Matrix<T, Allocator>::transpose() {
+	MATRIXCPP_INSTRUMENT(Transpose, 0);
 
-	for (std::size_t row = 0; row < rows; ++row) {
-		for (std::size_t column = 0; column < columns; ++column) {
-			transposed[row][column] = mRawMatrix[column][row];
-		}
+	if (isSquare()) {
+		detail::transposeSquareInPlace(mRows, mData, mStride);
+		return;
 	}
 
-	mRawMatrix = transposed;
-	mColumns = columns;
-	mRows = rows;
+	// The storage holds rows * columns elements in both shapes, so transpose through scratch into it
+	detail::ScratchBuffer<T> copy(mRows * mColumns);
+	for (std::size_t row = 0; row < mRows; ++row)
+		std::copy_n(mData + row * mStride, mColumns, copy.data() + row * mColumns);
+
+	std::size_t rows = mRows, columns = mColumns;
+	mRows = columns;
+	mColumns = rows;
+	mStride = rows;
+
+	detail::transposeBlock(rows, columns, copy.data(), columns, mData, mStride);
 }
 
-template<typename T>
-std::vector<T>& Matrix<T>::getDiagonalElements() const {
+template<typename T, typename Allocator>
+Matrix<T, Allocator> Matrix<T, Allocator>::transposed() const {
+	Matrix<T, Allocator> result;
+	transposed(result);
+	return result;
+}
+
+template<typename T, typename Allocator>
+void Matrix<T, Allocator>::transposed(Matrix<T, Allocator>& destination) const {
+	if (&destination == this) {
+		destination.transpose();
+		return;
+	}
+
+	MATRIXCPP_INSTRUMENT(Transpose, 0);
+
+	if (destination.mRows != mColumns || destination.mColumns != mRows) {
+		destination.freeStorage();
+		destination.allocateStorage(mColumns, mRows);
+	}
+
+	detail::transposeBlock(mRows, mColumns, mData, mStride, destination.mData, destination.mStride);
+}
+
+template<typename T, typename Allocator>
+std::vector<T> Matrix<T, Allocator>::getDiagonalElements() const {
 	if (!isSquare())
-		return *(new std::vector<T>(0));
-	
+		return std::vector<T>();
+
 	std::size_t elements = getRows();
-	std::vector<T>* diagonal = new std::vector<T>();
-	diagonal->reserve(elements);
+	std::vector<T> diagonal;
+	diagonal.reserve(elements);
 
 	for (std::size_t i = 0; i < elements; ++i)
-		diagonal->push_back(mRawMatrix[i][i]);
+		diagonal.push_back(mData[i * mStride + i]);
 
-	return *diagonal;
+	return diagonal;
 }
 
-template<typename T>
-std::vector<T>& Matrix<T>::getRowElements(std::size_t row) const {
-	if (row > mRows - 1)
-		return *(new std::vector<T>());
+template<typename T, typename Allocator>
+std::vector<T> Matrix<T, Allocator>::getRowElements(std::size_t row) const {
+	if (row >= mRows)
+		return std::vector<T>();
+
+	const T* data = mData + row * mStride;
+	return std::vector<T>(data, data + mColumns);
+}
 
-	std::vector<T>* elements = new std::vector<T>();
-	elements->reserve(mColumns);
+template<typename T, typename Allocator>
+std::vector<T> Matrix<T, Allocator>::getColumnElements(std::size_t column) const {
+	if (column >= mColumns)
+		return std::vector<T>();
 
-	for (std::size_t column = 0; column < mColumns; ++column) {
-		elements->push_back(mRawMatrix[row][column]);
+	std::vector<T> elements;
+	elements.reserve(mRows);
+
+	for (std::size_t row = 0; row < mRows; ++row) {
+		elements.push_back(mData[row * mStride + column]);
 	}
 
-	return *elements;
+	return elements;
 }
 
-template<typename T>
-std::vector<T>& Matrix<T>::getColumnElements(std::size_t column) const {
-	if (column > mColumns - 1)
-		return *(new std::vector<T>());
+template<typename T, typename Allocator>
+RowView<T> Matrix<T, Allocator>::getRow(std::size_t row) {
+	return RowView<T>(mData + row * mStride, mColumns);
+}
 
-	std::vector<T>* elements = new std::vector<T>();
-	elements->reserve(mRows);
+template<typename T, typename Allocator>
+RowView<const T> Matrix<T, Allocator>::getRow(std::size_t row) const {
+	return RowView<const T>(mData + row * mStride, mColumns);
+}
 
-	for (std::size_t row = 0; row < mRows; ++row) {
-		elements->push_back(mRawMatrix[row][column]);
-	}
+template<typename T, typename Allocator>
+ColumnView<T> Matrix<T, Allocator>::getColumn(std::size_t column) {
+	return ColumnView<T>(mData + column, mRows, static_cast<std::ptrdiff_t>(mStride));
+}
 
-	return *elements;
+template<typename T, typename Allocator>
+ColumnView<const T> Matrix<T, Allocator>::getColumn(std::size_t column) const {
+	return ColumnView<const T>(mData + column, mRows, static_cast<std::ptrdiff_t>(mStride));
 }
 
-template<typename T>
-Matrix<T>& Matrix<T>::Square() {
-	Matrix<T>* matrix = new Matrix<T>(*this);
+template<typename T, typename Allocator>
+DiagonalView<T> Matrix<T, Allocator>::getDiagonal() {
+	return DiagonalView<T>(mData, std::min(mRows, mColumns), static_cast<std::ptrdiff_t>(mStride) + 1);
+}
 
-	*matrix *= *this;
+template<typename T, typename Allocator>
+DiagonalView<const T> Matrix<T, Allocator>::getDiagonal() const {
+	return DiagonalView<const T>(mData, std::min(mRows, mColumns), static_cast<std::ptrdiff_t>(mStride) + 1);
+}
+
+template<typename T, typename Allocator>
+SubMatrixView<T> Matrix<T, Allocator>::getSubMatrix(std::size_t row, std::size_t column, std::size_t rows, std::size_t columns) {
+	return SubMatrixView<T>(mData + row * mStride + column, rows, columns, mStride);
+}
 
-	return *matrix;
+template<typename T, typename Allocator>
+SubMatrixView<const T> Matrix<T, Allocator>::getSubMatrix(std::size_t row, std::size_t column, std::size_t rows, std::size_t columns) const {
+	return SubMatrixView<const T>(mData + row * mStride + column, rows, columns, mStride);
+}
+
+template<typename T, typename Allocator>
+Matrix<T, Allocator> Matrix<T, Allocator>::Square() const {
+	MATRIXCPP_INSTRUMENT(Square, 0);
+	return *this * *this;
+}
+
+template<typename T, typename Allocator>
+Matrix<T, Allocator> Matrix<T, Allocator>::pow(std::size_t exponent) const {
+	if (!isSquare() || mRows == 0)
+		return *this;
+
+	const detail::ElementwiseKernels<T>& kernels = detail::getElementwiseKernels<T>();
+	const std::size_t n = mRows;
+	bool upper = true, lower = true;
+
+	for (std::size_t row = 0; row < n && (upper || lower); ++row) {
+		const T* data = mData + row * mStride;
+		upper = upper && kernels.isZero(data, row);
+		lower = lower && kernels.isZero(data + row + 1, n - row - 1);
+	}
+
+	std::size_t bits = 0, ones = 0;
+	for (std::size_t rest = exponent; rest != 0; rest >>= 1) {
+		++bits;
+		ones += rest & 1;
+	}
+
+	Matrix<T, Allocator> result(n, n, T(), mAllocator);
+
+	if (exponent == 0 || (upper && lower)) {
+		MATRIXCPP_INSTRUMENT(Power, static_cast<double>(n) * (bits + ones));
+
+		for (std::size_t i = 0; i < n; ++i) {
+			T base = mData[i * mStride + i], power = T(1);
+			for (std::size_t bits = exponent; bits != 0; bits >>= 1) {
+				if (bits & 1)
+					power *= base;
+				if (bits > 1)
+					base *= base;
+			}
+			result.mData[i * result.mStride + i] = power;
+		}
+
+		return result;
+	}
+
+	// Left-to-right binary powering: square for every bit after the highest one, multiply by the matrix for set bits
+	const std::size_t products = bits - 1 + ones - 1;
+	MATRIXCPP_INSTRUMENT(Power, products * ((upper || lower) ? 1.0 / 3.0 : 2.0) * n * n * n);
+
+	detail::ScratchBuffer<T> scratch(products > 0 ? n * n : 0);
+	T* current = result.mData;
+	T* next = scratch.data();
+	std::size_t currentStride = result.mStride, nextStride = n;
+
+	auto step = [&](const T* lhs, std::size_t strideL, const T* rhs, std::size_t strideR) {
+		if (upper || lower)
+			detail::multiplyTriangular(upper, n, lhs, strideL, rhs, strideR, next, nextStride);
+		else
+			detail::multiply<T>(n, n, n, lhs, strideL, rhs, strideR, next, nextStride);
+
+		std::swap(current, next);
+		std::swap(currentStride, nextStride);
+	};
+
+	for (std::size_t row = 0; row < n; ++row)
+		std::copy_n(mData + row * mStride, n, current + row * currentStride);
+
+	for (std::size_t bit = bits - 1; bit-- > 0;) {
+		step(current, currentStride, current, currentStride);
+		if ((exponent >> bit) & 1)
+			step(current, currentStride, mData, mStride);
+	}
+
+	if (current != result.mData) {
+		for (std::size_t row = 0; row < n; ++row)
+			std::copy_n(current + row * currentStride, n, result.mData + row * result.mStride);
+	}
+
+	return result;
 }
 /*
 template<class T>
@@ -446,7 +1013,7 @@ T Matrix<T>::getDeterminant() const {
 
 	if (decomposition->isEmpty)
 		return 0;
-	
+
 	std::vector<T>* LDiagonal = decomposition->L->getDiagonalElements();
 	std::vector<T>* UDiagonal = decomposition->U->getDiagonalElements();
 
@@ -461,18 +1028,18 @@ T Matrix<T>::getDeterminant() const {
 	return determinant;
 }
 */
-template<typename T>
-std::vector<T>& Matrix<T>::operator[](std::size_t row) {
-	return mRawMatrix[row];
+template<typename T, typename Allocator>
+RowView<T> Matrix<T, Allocator>::operator[](std::size_t row) {
+	return RowView<T>(mData + row * mStride, mColumns);
 }
 
-template<typename T>
-const std::vector<T>& Matrix<T>::operator[](std::size_t row) const {
-	return mRawMatrix[row];
+template<typename T, typename Allocator>
+RowView<const T> Matrix<T, Allocator>::operator[](std::size_t row) const {
+	return RowView<const T>(mData + row * mStride, mColumns);
 }
 
-template<typename T>
-Matrix<T>& Matrix<T>::operator+=(const Matrix<T>& rhs) {
+template<typename T, typename Allocator>
+Matrix<T, Allocator>& Matrix<T, Allocator>::operator+=(const Matrix<T, Allocator>& rhs) {
 	std::size_t rows = mRows, columns = mColumns;
 
 	if (rows != rhs.getRows()) {
@@ -482,17 +1049,24 @@ Matrix<T>& Matrix<T>::operator+=(const Matrix<T>& rhs) {
 		return *this;
 	}
 
+	MATRIXCPP_INSTRUMENT(AddAssign, rows * columns);
+
+	const detail::ElementwiseKernels<T>& kernels = detail::getElementwiseKernels<T>();
+
+	if (mStride == columns && rhs.getStride() == columns) {
+		columns *= rows;
+		rows = 1;
+	}
+
 	for (std::size_t row = 0; row < rows; ++row) {
-		for (std::size_t column = 0; column < columns; ++column) {
-			mRawMatrix[row][column] += rhs.get(row, column);
-		}
+		kernels.add(mData + row * mStride, rhs.getData() + row * rhs.getStride(), columns);
 	}
 
 	return *this;
 }
 
-template<typename T>
-Matrix<T>& Matrix<T>::operator-=(const Matrix<T>& rhs) {
+template<typename T, typename Allocator>
+Matrix<T, Allocator>& Matrix<T, Allocator>::operator-=(const Matrix<T, Allocator>& rhs) {
 	std::size_t rows = mRows, columns = mColumns;
 
 	if (rows != rhs.getRows()) {
@@ -502,92 +1076,249 @@ Matrix<T>& Matrix<T>::operator-=(const Matrix<T>& rhs) {
 		return *this;
 	}
 
+	MATRIXCPP_INSTRUMENT(SubtractAssign, rows * columns);
+
+	const detail::ElementwiseKernels<T>& kernels = detail::getElementwiseKernels<T>();
+
+	if (mStride == columns && rhs.getStride() == columns) {
+		columns *= rows;
+		rows = 1;
+	}
+
 	for (std::size_t row = 0; row < rows; ++row) {
-		for (std::size_t column = 0; column < columns; ++column) {
-			mRawMatrix[row][column] -= rhs.get(row, column);
-		}
+		kernels.subtract(mData + row * mStride, rhs.getData() + row * rhs.getStride(), columns);
 	}
 
 	return *this;
 }
 
-template<typename T>
-Matrix<T>& Matrix<T>::operator*=(const Matrix<T>& rhs) {
+template<typename T, typename Allocator>
+Matrix<T, Allocator>& Matrix<T, Allocator>::operator*=(const Matrix<T, Allocator>& rhs) {
 	if (mColumns != rhs.getRows())
 		return *this;
 
-	RawMatrix<T> matrix = *allocRawMatrix(mRows, mColumns);
+	MATRIXCPP_INSTRUMENT(MultiplyAssign, 2.0 * mRows * mColumns * rhs.getColumns());
 
-	for (std::size_t row = 0; row < mRows; ++row) {
-		for (std::size_t column = 0; column < mColumns; ++column) {
-			double result = 0; // Maybe need to change type?
-			for (std::size_t r = 0; r < mColumns; ++r) {
-				result += get(row, r) * rhs.get(r, column);
-			}
-			matrix[row][column] = result;
-		}
+	if (rhs.getColumns() == mColumns) {
+		// Shape stays the same: multiply into scratch and copy back without allocations
+		detail::ScratchBuffer<T> product(mRows * mColumns);
+
+		detail::multiply<T>(mRows, mColumns, mColumns, mData, mStride, rhs.getData(), rhs.getStride(), product.data(), mColumns);
+
+		for (std::size_t row = 0; row < mRows; ++row)
+			std::copy_n(product.data() + row * mColumns, mColumns, mData + row * mStride);
+
+		return *this;
 	}
 
-	mRawMatrix = matrix;
+	Matrix<T, Allocator> matrix(mRows, rhs.getColumns(), T(), mAllocator);
+
+	detail::multiply<T>(mRows, matrix.mColumns, mColumns, mData, mStride, rhs.getData(), rhs.getStride(), matrix.mData, matrix.mStride);
+
+	swap(matrix);
 
 	return *this;
 }
 
-template<typename T>
-Matrix<T>& Matrix<T>::operator*=(const T& value) {
+template<typename T, typename Allocator>
+Matrix<T, Allocator>& Matrix<T, Allocator>::operator*=(const T& value) {
+	MATRIXCPP_INSTRUMENT(ScaleAssign, mRows * mColumns);
+	const detail::ElementwiseKernels<T>& kernels = detail::getElementwiseKernels<T>();
 	std::size_t rows = mRows, columns = mColumns;
 
-	for (auto & i : mRawMatrix) {
-		for (T & el : i) {
-			el *= value;
-		}
+	if (mStride == columns) {
+		columns *= rows;
+		rows = 1;
+	}
+
+	for (std::size_t row = 0; row < rows; ++row) {
+		kernels.multiply(mData + row * mStride, value, columns);
 	}
 
 	return *this;
 }
 
-template<typename T>
-Matrix<T>& Matrix<T>::operator/=(const T& value) {
+template<typename T, typename Allocator>
+Matrix<T, Allocator>& Matrix<T, Allocator>::operator/=(const T& value) {
+	MATRIXCPP_INSTRUMENT(ScaleAssign, mRows * mColumns);
+	const detail::ElementwiseKernels<T>& kernels = detail::getElementwiseKernels<T>();
 	std::size_t rows = mRows, columns = mColumns;
 
-	for (auto & i : mRawMatrix) {
-		for (T & el : i) {
-			el /= value;
-		}
+	if (mStride == columns) {
+		columns *= rows;
+		rows = 1;
+	}
+
+	for (std::size_t row = 0; row < rows; ++row) {
+		kernels.divide(mData + row * mStride, value, columns);
 	}
-	
+
 	return *this;
 }
 
-template<typename T>
-Matrix<T> Matrix<T>::operator-() {
-	Matrix<T> matrix(*this);
+template<typename T, typename Allocator>
+template<typename E>
+Matrix<T, Allocator>& Matrix<T, Allocator>::operator+=(const MatrixExpression<E, T>& rhs) {
+	const E& e = rhs.derived();
 
-	for (std::size_t r = 0; r < mRows; ++r) {
-		for (std::size_t c = 0; c < mColumns; ++c) {
-			matrix.set(r, c, -get(r, c));
-		}
-	}
+	if (mRows != e.getRows() || mColumns != e.getColumns())
+		return *this;
 
-	return matrix;
+	MATRIXCPP_INSTRUMENT(AddAssign, mRows * mColumns);
+	assignExpression(e, [](T& el, const T& value) { return el + value; });
+
+	return *this;
 }
 
-template<typename T>
-RawMatrix<T>* Matrix<T>::allocRawMatrix(std::size_t rows, std::size_t columns, T defaultValue) const {
-	RawMatrix<T>* rawMatrix = new RawMatrix<T>(rows);
+template<typename T, typename Allocator>
+template<typename E>
+Matrix<T, Allocator>& Matrix<T, Allocator>::operator-=(const MatrixExpression<E, T>& rhs) {
+	const E& e = rhs.derived();
 
-	for (auto & r : *rawMatrix) {
-		r = std::vector<T>(columns);
-		for (auto & el : r) {
-			el = defaultValue;
+	if (mRows != e.getRows() || mColumns != e.getColumns())
+		return *this;
+
+	MATRIXCPP_INSTRUMENT(SubtractAssign, mRows * mColumns);
+	assignExpression(e, [](T& el, const T& value) { return el - value; });
+
+	return *this;
+}
+
+template<typename T, typename Allocator>
+template<typename E>
+Matrix<T, Allocator>& Matrix<T, Allocator>::operator*=(const MatrixExpression<E, T>& rhs) {
+	return *this *= Matrix<T, Allocator>(rhs);
+}
+
+template<typename T, typename Allocator>
+template<typename E, typename Operation>
+void Matrix<T, Allocator>::assignExpression(const E& expression, Operation operation) {
+	if (expression.isConformable()) {
+		for (std::size_t row = 0; row < mRows; ++row) {
+			T* data = mData + row * mStride;
+			for (std::size_t column = 0; column < mColumns; ++column)
+				data[column] = operation(data[column], expression.evaluate(row, column));
+		}
+	} else {
+		for (std::size_t row = 0; row < mRows; ++row) {
+			T* data = mData + row * mStride;
+			for (std::size_t column = 0; column < mColumns; ++column)
+				data[column] = operation(data[column], expression.get(row, column));
 		}
 	}
+}
 
-	return rawMatrix;
+template<typename T, typename Allocator>
+void Matrix<T, Allocator>::allocateStorage(std::size_t rows, std::size_t columns, T defaultValue) {
+	mRows = rows;
+	mColumns = columns;
+	mStride = columns;
+	mData = nullptr;
+
+	std::size_t count = rows * columns;
+	if (count == 0)
+		return;
+
+	MATRIXCPP_RECORD_ALLOCATION(count * sizeof(T));
+	mData = AllocatorTraits::allocate(mAllocator, count);
+	std::uninitialized_fill_n(mData, count, defaultValue);
+}
+
+template<typename T, typename Allocator>
+void Matrix<T, Allocator>::freeStorage() {
+	if (mMapping) {
+		// Elements of mapped matrices are trivial and belong to the file
+		mMapping.reset();
+		mData = nullptr;
+		return;
+	}
+
+	if (mData == nullptr)
+		return;
+
+	std::destroy_n(mData, mRows * mStride);
+	AllocatorTraits::deallocate(mAllocator, mData, mRows * mStride);
+	mData = nullptr;
 }
 
+namespace detail {
+
+/**
+ * @brief Expression as a dense block in memory: matrices and blocks are used in place,
+ * other expressions are evaluated into a temporary matrix
+ * 
+ */
+template<typename E>
+class DenseOperand {
+public:
+	using ValueType = typename E::ValueType;
+
+	explicit DenseOperand(const E& expression) : mMatrix(expression) {}
+
+	const ValueType* getData() const { return mMatrix.getData(); }
+	std::size_t getStride() const { return mMatrix.getStride(); }
+	std::size_t getRows() const { return mMatrix.getRows(); }
+	std::size_t getColumns() const { return mMatrix.getColumns(); }
+
+private:
+	Matrix<ValueType> mMatrix;
+};
+
+template<typename T, typename Allocator>
+class DenseOperand<Matrix<T, Allocator>> {
+public:
+	explicit DenseOperand(const Matrix<T, Allocator>& matrix) : mData(matrix.getData()), mRows(matrix.getRows()), mColumns(matrix.getColumns()), mStride(matrix.getStride()) {}
+
+	const T* getData() const { return mData; }
+	std::size_t getStride() const { return mStride; }
+	std::size_t getRows() const { return mRows; }
+	std::size_t getColumns() const { return mColumns; }
+
+private:
+	const T* mData;
+	std::size_t mRows, mColumns, mStride;
+};
+
 template<typename T>
-bool operator==(Matrix<T> const& lhs, Matrix<T> const& rhs) {
+class DenseOperand<SubMatrixView<T>> {
+public:
+	explicit DenseOperand(const SubMatrixView<T>& view) : mData(view.getData()), mRows(view.getRows()), mColumns(view.getColumns()), mStride(view.getStride()) {}
+
+	const T* getData() const { return mData; }
+	std::size_t getStride() const { return mStride; }
+	std::size_t getRows() const { return mRows; }
+	std::size_t getColumns() const { return mColumns; }
+
+private:
+	const T* mData;
+	std::size_t mRows, mColumns, mStride;
+};
+
+/**
+ * @brief Allocator of results computed from an expression: matrices pass on their own allocator,
+ * other expressions give the default one
+ * 
+ */
+template<typename E>
+struct ResultAllocator {
+	using Type = AlignedAllocator<typename E::ValueType>;
+
+	static Type get(const E&) { return Type(); }
+};
+
+template<typename T, typename Allocator>
+struct ResultAllocator<Matrix<T, Allocator>> {
+	using Type = Allocator;
+
+	static Type get(const Matrix<T, Allocator>& matrix) { return matrix.getAllocator(); }
+};
+
+}
+
+template<typename T, typename LeftAllocator, typename RightAllocator>
+bool operator==(Matrix<T, LeftAllocator> const& lhs, Matrix<T, RightAllocator> const& rhs) {
+	MATRIXCPP_INSTRUMENT(Compare, 0);
+
 	if (!(lhs.getRows() == rhs.getRows() && lhs.getColumns() == rhs.getColumns()))
 		return false;
 
@@ -603,4 +1334,61 @@ bool operator==(Matrix<T> const& lhs, Matrix<T> const& rhs) {
 	return true;
 }
 
-}
\ No newline at end of file
+/**
+ * @brief Overloading for operator * (multiplying matrix by matrix)
+ * @details If sizes don't fit, the result is the left matrix (as with `lhs *= rhs`)
+ * 
+ * @param lhs Left matrix
+ * @param rhs Right matrix
+ * @return Matrix<T, Allocator> Multiplied matrix (with allocator of lhs, if it's a matrix)
+ */
+template<typename L, typename R, typename T>
+Matrix<T, typename detail::ResultAllocator<L>::Type> operator*(const MatrixExpression<L, T>& lhs, const MatrixExpression<R, T>& rhs) {
+	using Result = Matrix<T, typename detail::ResultAllocator<L>::Type>;
+	const detail::DenseOperand<L> a(lhs.derived());
+	const detail::DenseOperand<R> b(rhs.derived());
+
+	if (a.getColumns() != b.getRows())
+		return Result(lhs.derived());
+
+	MATRIXCPP_INSTRUMENT(Multiply, 2.0 * a.getRows() * a.getColumns() * b.getColumns());
+	Result result(a.getRows(), b.getColumns(), T(), detail::ResultAllocator<L>::get(lhs.derived()));
+
+	detail::multiply<T>(a.getRows(), b.getColumns(), a.getColumns(), a.getData(), a.getStride(),
+	                    b.getData(), b.getStride(), result.getData(), result.getStride());
+
+	return result;
+}
+
+/**
+ * @brief Multiplies matrices by Strassen-Winograd recursion
+ * @details operator* switches to it by itself for square matrices from getStrassenCrossover().
+ * This works for any shapes and lets choose where recursion stops. The result differs
+ * from the usual product by rounding (error bound grows with the depth of recursion).
+ * If sizes don't fit, the result is the left matrix (as with `lhs * rhs`)
+ * 
+ * @param lhs Left matrix
+ * @param rhs Right matrix
+ * @param crossover Blocks with a dimension smaller than this are multiplied by the blocked kernel
+ * @return Matrix<T, Allocator> Multiplied matrix (with allocator of lhs, if it's a matrix)
+ */
+template<typename L, typename R, typename T>
+Matrix<T, typename detail::ResultAllocator<L>::Type> strassenMultiply(const MatrixExpression<L, T>& lhs, const MatrixExpression<R, T>& rhs,
+                                                                    std::size_t crossover = detail::StrassenCrossover) {
+	using Result = Matrix<T, typename detail::ResultAllocator<L>::Type>;
+	const detail::DenseOperand<L> a(lhs.derived());
+	const detail::DenseOperand<R> b(rhs.derived());
+
+	if (a.getColumns() != b.getRows())
+		return Result(lhs.derived());
+
+	MATRIXCPP_INSTRUMENT(Multiply, 2.0 * a.getRows() * a.getColumns() * b.getColumns());
+	Result result(a.getRows(), b.getColumns(), T(), detail::ResultAllocator<L>::get(lhs.derived()));
+
+	detail::strassen<T>(a.getRows(), b.getColumns(), a.getColumns(), T(1), a.getData(), a.getStride(),
+	                    b.getData(), b.getStride(), T(), result.getData(), result.getStride(), crossover);
+
+	return result;
+}
+
+}
@@ -0,0 +1,508 @@
+/**
+ * @brief Batches of same-shaped small matrices in structure-of-arrays layout
+ *
+ * @file MatrixBatch.hpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include "Matrix.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace MatrixCpp {
+
+namespace detail {
+
+/**
+ * @brief Number of batch elements processed by one task (and kept in one scratch block)
+ *
+ */
+constexpr std::size_t BatchChunk = 256;
+
+}
+
+/**
+ * @brief Batch of count matrices of the same shape (rows x columns)
+ * @details Element (row, column) of every matrix in the batch is stored contiguously
+ * (structure of arrays), so loops over the batch run in SIMD lanes, one matrix per lane.
+ * Operations are split into chunks of batch elements which run in parallel.
+ *
+ * @tparam T Type of elements
+ */
+template<typename T>
+class MatrixBatch {
+public:
+    static constexpr std::size_t Alignment = 64;
+
+    /**
+     * @brief Construct a new empty MatrixBatch object
+     *
+     */
+    MatrixBatch();
+
+    /**
+     * @brief Construct a new MatrixBatch object
+     *
+     * @param count Number of matrices
+     * @param rows Number of rows in every matrix
+     * @param columns Number of columns in every matrix
+     * @param defaultValue Value of every element
+     */
+    MatrixBatch(std::size_t count, std::size_t rows, std::size_t columns, T defaultValue = T());
+
+    MatrixBatch(const MatrixBatch& batch);
+    MatrixBatch(MatrixBatch&& batch) noexcept;
+    MatrixBatch& operator=(const MatrixBatch& batch);
+    MatrixBatch& operator=(MatrixBatch&& batch) noexcept;
+    ~MatrixBatch();
+
+    void swap(MatrixBatch& batch) noexcept;
+
+    std::size_t getCount() const { return mCount; }
+    std::size_t getRows() const { return mRows; }
+    std::size_t getColumns() const { return mColumns; }
+
+    /**
+     * @brief Get distance between the same batch element of neighbour matrix elements
+     *
+     * @return std::size_t Count rounded up to the SIMD width
+     */
+    std::size_t getBatchStride() const { return mBatchStride; }
+
+    /**
+     * @brief Get element (row, column) of all matrices (getCount() contiguous values)
+     *
+     * @param row Row
+     * @param column Column
+     * @return T* Pointer to element of the first matrix
+     */
+    T* getElements(std::size_t row, std::size_t column) { return mData + (row * mColumns + column) * mBatchStride; }
+    const T* getElements(std::size_t row, std::size_t column) const { return mData + (row * mColumns + column) * mBatchStride; }
+
+    T get(std::size_t index, std::size_t row, std::size_t column) const { return getElements(row, column)[index]; }
+    void set(std::size_t index, std::size_t row, std::size_t column, T value) { getElements(row, column)[index] = value; }
+
+    /**
+     * @brief Copy matrix out of batch
+     *
+     * @param index Index of matrix
+     * @return Matrix<T> Matrix
+     */
+    Matrix<T> getMatrix(std::size_t index) const;
+
+    /**
+     * @brief Copy matrix into batch (nothing happens if shape doesn't match)
+     *
+     * @param index Index of matrix
+     * @param matrix Matrix
+     */
+    void setMatrix(std::size_t index, const Matrix<T>& matrix);
+
+    MatrixBatch& operator+=(const MatrixBatch& rhs);
+    MatrixBatch& operator-=(const MatrixBatch& rhs);
+    MatrixBatch& operator*=(const T& value);
+
+    /**
+     * @brief Determinants of all matrices (same semantics as Determinant)
+     *
+     * @return std::vector<T> Determinants (empty if matrices aren't square)
+     */
+    std::vector<T> getDeterminants() const;
+
+    /**
+     * @brief Solves A[i] * X[i] = B[i] for every matrix of batch by LU with partial pivoting
+     * @details A matrix is singular when U has zero on the diagonal, as in LUDecomposition::isSingular.
+     * LUDecomposition::solve returns nothing for it, here the other matrices are still solved
+     * and X[i] of a singular A[i] is filled with zeros. Use the overload with singular to tell
+     * them from real zero solutions.
+     *
+     * @param B Right-hand sides (one batch element per matrix, rows must match)
+     * @return MatrixBatch<T> Solutions (empty if matrices aren't square or shapes don't match)
+     */
+    MatrixBatch solve(const MatrixBatch& B) const;
+
+    /**
+     * @brief Solves A[i] * X[i] = B[i] for every matrix of batch and reports singular matrices
+     *
+     * @param B Right-hand sides (one batch element per matrix, rows must match)
+     * @param singular Gets getCount() flags, true for every singular A[i] (empty if nothing was solved)
+     * @return MatrixBatch<T> Solutions (empty if matrices aren't square or shapes don't match)
+     */
+    MatrixBatch solve(const MatrixBatch& B, std::vector<bool>& singular) const;
+
+    /**
+     * @brief Overloading for operator * (multiplying every pair of matrices)
+     *
+     * @param lhs Left batch
+     * @param rhs Right batch
+     * @return MatrixBatch Products (lhs if shapes or counts don't match)
+     */
+    friend MatrixBatch operator*(const MatrixBatch& lhs, const MatrixBatch& rhs) {
+        if (lhs.mColumns != rhs.mRows || lhs.mCount != rhs.mCount)
+            return lhs;
+
+        MatrixBatch result(lhs.mCount, lhs.mRows, rhs.mColumns);
+        std::size_t inner = lhs.mColumns;
+
+        result.forEachChunk([&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = 0; i < result.mRows; ++i) {
+                for (std::size_t j = 0; j < result.mColumns; ++j) {
+                    T* destination = result.getElements(i, j);
+                    for (std::size_t k = 0; k < inner; ++k) {
+                        const T* a = lhs.getElements(i, k);
+                        const T* b = rhs.getElements(k, j);
+                        for (std::size_t lane = begin; lane < end; ++lane)
+                            destination[lane] += a[lane] * b[lane];
+                    }
+                }
+            }
+        });
+
+        return result;
+    }
+
+    friend MatrixBatch operator+(MatrixBatch lhs, const MatrixBatch& rhs) { return std::move(lhs += rhs); }
+    friend MatrixBatch operator-(MatrixBatch lhs, const MatrixBatch& rhs) { return std::move(lhs -= rhs); }
+    friend MatrixBatch operator*(MatrixBatch lhs, const T& rhs) { return std::move(lhs *= rhs); }
+    friend MatrixBatch operator*(const T& lhs, MatrixBatch rhs) { return std::move(rhs *= lhs); }
+
+private:
+    /**
+     * @brief Calls body(begin, end) for chunks of batch elements in parallel
+     *
+     */
+    template<typename F>
+    void forEachChunk(const F& body) const;
+
+    /**
+     * @brief Elementwise operation on two batches of the same shape
+     *
+     */
+    template<typename Operation>
+    MatrixBatch& apply(const MatrixBatch& rhs, Operation operation);
+
+    /**
+     * @brief Eliminates below diagonal of A (n x n) in scratch, applying the same row operations
+     * to m more columns stored after A, for lanes of one chunk
+     * @details Pivoting is branch-free: every row below the diagonal is compared with the pivot row
+     * and they are swapped in lanes where it's bigger, so all lanes follow the same instructions
+     *
+     * @param scratch Augmented matrices, element (row, column) of lane at (row * (n + m) + column) * lanes + lane
+     * @param n Size of A
+     * @param m Number of extra columns
+     * @param lanes Number of lanes in chunk
+     * @param sign Sign of row permutation of every lane
+     */
+    static void eliminate(T* scratch, std::size_t n, std::size_t m, std::size_t lanes, T* sign);
+
+    void allocateStorage(std::size_t count, std::size_t rows, std::size_t columns, T defaultValue = T());
+    void freeStorage();
+
+    std::size_t mCount;
+    std::size_t mRows;
+    std::size_t mColumns;
+    std::size_t mBatchStride;
+    T* mData;
+};
+
+template<typename T>
+MatrixBatch<T>::MatrixBatch() : mCount(0), mRows(0), mColumns(0), mBatchStride(0), mData(nullptr) {}
+
+template<typename T>
+MatrixBatch<T>::MatrixBatch(std::size_t count, std::size_t rows, std::size_t columns, T defaultValue) {
+    allocateStorage(count, rows, columns, defaultValue);
+}
+
+template<typename T>
+MatrixBatch<T>::MatrixBatch(const MatrixBatch& batch) {
+    allocateStorage(batch.mCount, batch.mRows, batch.mColumns);
+    std::copy_n(batch.mData, mRows * mColumns * mBatchStride, mData);
+}
+
+template<typename T>
+MatrixBatch<T>::MatrixBatch(MatrixBatch&& batch) noexcept : MatrixBatch() {
+    swap(batch);
+}
+
+template<typename T>
+MatrixBatch<T>& MatrixBatch<T>::operator=(const MatrixBatch& batch) {
+    if (this != &batch) {
+        MatrixBatch copy(batch);
+        swap(copy);
+    }
+    return *this;
+}
+
+template<typename T>
+MatrixBatch<T>& MatrixBatch<T>::operator=(MatrixBatch&& batch) noexcept {
+    MatrixBatch moved(std::move(batch));
+    swap(moved);
+    return *this;
+}
+
+template<typename T>
+MatrixBatch<T>::~MatrixBatch() {
+    freeStorage();
+}
+
+template<typename T>
+void MatrixBatch<T>::swap(MatrixBatch& batch) noexcept {
+    std::swap(mCount, batch.mCount);
+    std::swap(mRows, batch.mRows);
+    std::swap(mColumns, batch.mColumns);
+    std::swap(mBatchStride, batch.mBatchStride);
+    std::swap(mData, batch.mData);
+}
+
+template<typename T>
+Matrix<T> MatrixBatch<T>::getMatrix(std::size_t index) const {
+    Matrix<T> matrix(mRows, mColumns);
+    for (std::size_t row = 0; row < mRows; ++row)
+        for (std::size_t column = 0; column < mColumns; ++column)
+            matrix.getData()[row * matrix.getStride() + column] = get(index, row, column);
+    return matrix;
+}
+
+template<typename T>
+void MatrixBatch<T>::setMatrix(std::size_t index, const Matrix<T>& matrix) {
+    if (matrix.getRows() != mRows || matrix.getColumns() != mColumns)
+        return;
+
+    for (std::size_t row = 0; row < mRows; ++row)
+        for (std::size_t column = 0; column < mColumns; ++column)
+            set(index, row, column, matrix.getData()[row * matrix.getStride() + column]);
+}
+
+template<typename T>
+MatrixBatch<T>& MatrixBatch<T>::operator+=(const MatrixBatch& rhs) {
+    return apply(rhs, [](T& lhs, const T& value) { lhs += value; });
+}
+
+template<typename T>
+MatrixBatch<T>& MatrixBatch<T>::operator-=(const MatrixBatch& rhs) {
+    return apply(rhs, [](T& lhs, const T& value) { lhs -= value; });
+}
+
+template<typename T>
+MatrixBatch<T>& MatrixBatch<T>::operator*=(const T& value) {
+    forEachChunk([&](std::size_t begin, std::size_t end) {
+        for (std::size_t element = 0; element < mRows * mColumns; ++element) {
+            T* data = mData + element * mBatchStride;
+            for (std::size_t lane = begin; lane < end; ++lane)
+                data[lane] *= value;
+        }
+    });
+    return *this;
+}
+
+template<typename T>
+template<typename Operation>
+MatrixBatch<T>& MatrixBatch<T>::apply(const MatrixBatch& rhs, Operation operation) {
+    if (rhs.mRows != mRows || rhs.mColumns != mColumns || rhs.mCount != mCount)
+        return *this;
+
+    forEachChunk([&](std::size_t begin, std::size_t end) {
+        for (std::size_t element = 0; element < mRows * mColumns; ++element) {
+            T* data = mData + element * mBatchStride;
+            const T* source = rhs.mData + element * rhs.mBatchStride;
+            for (std::size_t lane = begin; lane < end; ++lane)
+                operation(data[lane], source[lane]);
+        }
+    });
+    return *this;
+}
+
+template<typename T>
+std::vector<T> MatrixBatch<T>::getDeterminants() const {
+    if (mRows != mColumns)
+        return std::vector<T>();
+
+    std::vector<T> determinants(mCount);
+    std::size_t n = mRows;
+
+    forEachChunk([&](std::size_t begin, std::size_t end) {
+        std::size_t lanes = end - begin;
+        detail::ScratchBuffer<T> scratch(n * n * lanes), sign(lanes);
+
+        for (std::size_t element = 0; element < n * n; ++element)
+            std::copy_n(mData + element * mBatchStride + begin, lanes, scratch.data() + element * lanes);
+
+        eliminate(scratch.data(), n, 0, lanes, sign.data());
+
+        T* result = determinants.data() + begin;
+        std::copy_n(sign.data(), lanes, result);
+        for (std::size_t k = 0; k < n; ++k) {
+            const T* diagonal = scratch.data() + (k * n + k) * lanes;
+            for (std::size_t lane = 0; lane < lanes; ++lane)
+                result[lane] *= diagonal[lane];
+        }
+    });
+
+    return determinants;
+}
+
+template<typename T>
+MatrixBatch<T> MatrixBatch<T>::solve(const MatrixBatch& B) const {
+    std::vector<bool> singular;
+    return solve(B, singular);
+}
+
+template<typename T>
+MatrixBatch<T> MatrixBatch<T>::solve(const MatrixBatch& B, std::vector<bool>& singularMatrices) const {
+    singularMatrices.clear();
+
+    if (mRows != mColumns || B.mRows != mRows || B.mCount != mCount)
+        return MatrixBatch();
+
+    std::size_t n = mRows, m = B.mColumns, width = n + m;
+    MatrixBatch X(mCount, n, m);
+    // std::vector<bool> packs flags into shared words, so chunks write bytes
+    std::vector<unsigned char> flags(mCount);
+
+    forEachChunk([&](std::size_t begin, std::size_t end) {
+        std::size_t lanes = end - begin;
+        detail::ScratchBuffer<T> scratch(n * width * lanes), sign(lanes), singular(lanes);
+        std::fill_n(singular.data(), lanes, T());
+
+        // Augmented matrices [A | B]
+        for (std::size_t row = 0; row < n; ++row) {
+            for (std::size_t column = 0; column < n; ++column)
+                std::copy_n(getElements(row, column) + begin, lanes, scratch.data() + (row * width + column) * lanes);
+            for (std::size_t column = 0; column < m; ++column)
+                std::copy_n(B.getElements(row, column) + begin, lanes, scratch.data() + (row * width + n + column) * lanes);
+        }
+
+        eliminate(scratch.data(), n, m, lanes, sign.data());
+
+        for (std::size_t k = 0; k < n; ++k) {
+            const T* diagonal = scratch.data() + (k * width + k) * lanes;
+            for (std::size_t lane = 0; lane < lanes; ++lane)
+                singular[lane] = diagonal[lane] == T() ? T(1) : singular[lane];
+        }
+
+        // Back substitution, solutions replace right-hand sides in scratch
+        for (std::size_t i = n; i-- > 0;) {
+            const T* diagonal = scratch.data() + (i * width + i) * lanes;
+            for (std::size_t j = 0; j < m; ++j) {
+                T* x = scratch.data() + (i * width + n + j) * lanes;
+                for (std::size_t k = i + 1; k < n; ++k) {
+                    const T* a = scratch.data() + (i * width + k) * lanes;
+                    const T* solved = scratch.data() + (k * width + n + j) * lanes;
+                    for (std::size_t lane = 0; lane < lanes; ++lane)
+                        x[lane] -= a[lane] * solved[lane];
+                }
+                for (std::size_t lane = 0; lane < lanes; ++lane)
+                    x[lane] = singular[lane] == T() ? x[lane] / diagonal[lane] : T();
+            }
+        }
+
+        for (std::size_t row = 0; row < n; ++row)
+            for (std::size_t column = 0; column < m; ++column)
+                std::copy_n(scratch.data() + (row * width + n + column) * lanes, lanes, X.getElements(row, column) + begin);
+
+        for (std::size_t lane = 0; lane < lanes; ++lane)
+            flags[begin + lane] = singular[lane] != T();
+    });
+
+    singularMatrices.assign(flags.begin(), flags.end());
+    return X;
+}
+
+template<typename T>
+void MatrixBatch<T>::eliminate(T* scratch, std::size_t n, std::size_t m, std::size_t lanes, T* sign) {
+    std::size_t width = n + m;
+    detail::ScratchBuffer<unsigned char> swapMask(lanes);
+    detail::ScratchBuffer<T> factor(lanes);
+
+    std::fill_n(sign, lanes, T(1));
+
+    auto element = [&](std::size_t row, std::size_t column) { return scratch + (row * width + column) * lanes; };
+    auto magnitude = [](const T& value) { return value < T() ? -value : value; };
+
+    for (std::size_t k = 0; k < n; ++k) {
+        for (std::size_t row = k + 1; row < n; ++row) {
+            const T* pivot = element(k, k);
+            const T* candidate = element(row, k);
+            for (std::size_t lane = 0; lane < lanes; ++lane)
+                swapMask[lane] = magnitude(pivot[lane]) < magnitude(candidate[lane]);
+
+            for (std::size_t column = k; column < width; ++column) {
+                T* upper = element(k, column);
+                T* lower = element(row, column);
+                for (std::size_t lane = 0; lane < lanes; ++lane) {
+                    T first = upper[lane], second = lower[lane];
+                    upper[lane] = swapMask[lane] ? second : first;
+                    lower[lane] = swapMask[lane] ? first : second;
+                }
+            }
+
+            for (std::size_t lane = 0; lane < lanes; ++lane)
+                sign[lane] = swapMask[lane] ? -sign[lane] : sign[lane];
+        }
+
+        const T* pivot = element(k, k);
+        for (std::size_t row = k + 1; row < n; ++row) {
+            const T* first = element(row, k);
+            for (std::size_t lane = 0; lane < lanes; ++lane)
+                factor[lane] = pivot[lane] == T() ? T() : first[lane] / (pivot[lane] == T() ? T(1) : pivot[lane]);
+
+            for (std::size_t column = k + 1; column < width; ++column) {
+                T* target = element(row, column);
+                const T* source = element(k, column);
+                for (std::size_t lane = 0; lane < lanes; ++lane)
+                    target[lane] -= factor[lane] * source[lane];
+            }
+        }
+    }
+}
+
+template<typename T>
+template<typename F>
+void MatrixBatch<T>::forEachChunk(const F& body) const {
+    std::size_t chunks = (mCount + detail::BatchChunk - 1) / detail::BatchChunk;
+
+    parallelFor(chunks, [&](std::size_t chunk) {
+        std::size_t begin = chunk * detail::BatchChunk;
+        body(begin, std::min(begin + detail::BatchChunk, mCount));
+    });
+}
+
+template<typename T>
+void MatrixBatch<T>::allocateStorage(std::size_t count, std::size_t rows, std::size_t columns, T defaultValue) {
+    constexpr std::size_t Lanes = Alignment / sizeof(T) > 0 ? Alignment / sizeof(T) : 1;
+
+    mCount = count;
+    mRows = rows;
+    mColumns = columns;
+    mBatchStride = (count + Lanes - 1) / Lanes * Lanes;
+    mData = nullptr;
+
+    std::size_t total = rows * columns * mBatchStride;
+    if (total == 0)
+        return;
+
+    std::size_t bytes = (total * sizeof(T) + Alignment - 1) / Alignment * Alignment;
+    mData = static_cast<T*>(::operator new(bytes, std::align_val_t(Alignment)));
+    std::uninitialized_fill_n(mData, total, defaultValue);
+}
+
+template<typename T>
+void MatrixBatch<T>::freeStorage() {
+    if (mData == nullptr)
+        return;
+
+    std::destroy_n(mData, mRows * mColumns * mBatchStride);
+    ::operator delete(mData, std::align_val_t(Alignment));
+    mData = nullptr;
+}
+
+}
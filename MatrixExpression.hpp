@@ -0,0 +1,287 @@
+/**
+ * @brief Lazy expressions for elementwise arithmetic on matrices
+ *
+ * @file MatrixExpression.hpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include "Allocator.hpp"
+
+#include <cstddef>
+#include <functional>
+
+namespace MatrixCpp {
+
+template<typename L, typename R, typename Operation>
+class MatrixBinaryExpression;
+
+template<typename E, typename Operation>
+class MatrixScalarExpression;
+
+template<typename E>
+class MatrixNegateExpression;
+
+namespace detail {
+
+struct AddOperation {
+    template<typename T>
+    static T apply(const T& lhs, const T& rhs) { return lhs + rhs; }
+};
+
+struct SubtractOperation {
+    template<typename T>
+    static T apply(const T& lhs, const T& rhs) { return lhs - rhs; }
+};
+
+struct MultiplyOperation {
+    template<typename T>
+    static T apply(const T& lhs, const T& rhs) { return lhs * rhs; }
+};
+
+struct DivideOperation {
+    template<typename T>
+    static T apply(const T& lhs, const T& rhs) { return lhs / rhs; }
+};
+
+/**
+ * @brief How expression keeps its operand: matrices by reference, small nodes by value
+ *
+ */
+template<typename E>
+struct ExpressionOperand {
+    using Type = const E;
+};
+
+template<typename T, typename Allocator>
+struct ExpressionOperand<Matrix<T, Allocator>> {
+    using Type = const Matrix<T, Allocator>&;
+};
+
+/**
+ * @brief Checks whether rows x columns block with given stride shares memory with [begin, end)
+ *
+ */
+template<typename T>
+bool overlapsBlock(const T* data, std::size_t rows, std::size_t columns, std::size_t stride, const T* begin, const T* end) {
+    if (rows == 0 || columns == 0 || begin == end)
+        return false;
+
+    const T* last = data + (rows - 1) * stride + columns;
+    return std::less<const T*>()(data, end) && std::less<const T*>()(begin, last);
+}
+
+}
+
+/**
+ * @brief Base of everything that can be evaluated into a matrix
+ * @details Arithmetic on expressions builds a tree of nodes and computes nothing.
+ * The whole tree is evaluated in one pass when it's assigned to a Matrix.
+ * Every expression provides:
+ *  - getRows(), getColumns() - shape of result
+ *  - get(row, column) - element of result
+ *  - isConformable() - shapes of all operands match each other
+ *  - evaluate(row, column) - element of result without checks (only when conformable)
+ *  - overlaps(begin, end) - whether some operand reads memory in [begin, end)
+ *
+ * Nodes keep matrices by reference, so don't keep an expression (e.g. in `auto`)
+ * longer than matrices it was built from.
+ *
+ * @tparam E Type of expression (CRTP)
+ * @tparam T Type of elements
+ */
+template<typename E, typename T>
+class MatrixExpression {
+public:
+    using ValueType = T;
+
+    /**
+     * @brief Get the real expression
+     *
+     * @return const E& Expression
+     */
+    const E& derived() const {
+        return static_cast<const E&>(*this);
+    }
+
+    /**
+     * @brief Overloading for operator * (multiplying matrix by number)
+     *
+     * @param lhs Matrix to multiply
+     * @param rhs Number to multiply
+     * @return MatrixScalarExpression Lazy multiplied matrix
+     */
+    friend MatrixScalarExpression<E, detail::MultiplyOperation> operator*(const MatrixExpression& lhs, const T& rhs) {
+        return MatrixScalarExpression<E, detail::MultiplyOperation>(lhs.derived(), rhs);
+    }
+
+    /**
+     * @brief Overloading for operator * (multiplying number by matrix)
+     *
+     * @param lhs Number to multiply
+     * @param rhs Matrix to multiply
+     * @return MatrixScalarExpression Lazy multiplied matrix
+     */
+    friend MatrixScalarExpression<E, detail::MultiplyOperation> operator*(const T& lhs, const MatrixExpression& rhs) {
+        return MatrixScalarExpression<E, detail::MultiplyOperation>(rhs.derived(), lhs);
+    }
+
+    /**
+     * @brief Overloading for operator / (dividing matrix by number)
+     *
+     * @param lhs Matrix to divide
+     * @param rhs Number to divide
+     * @return MatrixScalarExpression Lazy divided matrix
+     */
+    friend MatrixScalarExpression<E, detail::DivideOperation> operator/(const MatrixExpression& lhs, const T& rhs) {
+        return MatrixScalarExpression<E, detail::DivideOperation>(lhs.derived(), rhs);
+    }
+
+    /**
+     * @brief Multiplies matrix by -1
+     *
+     * @param expression Matrix
+     * @return MatrixNegateExpression Lazy matrix with multiplied by -1 elements
+     */
+    friend MatrixNegateExpression<E> operator-(const MatrixExpression& expression) {
+        return MatrixNegateExpression<E>(expression.derived());
+    }
+
+protected:
+    MatrixExpression() = default;
+    MatrixExpression(const MatrixExpression&) = default;
+    MatrixExpression& operator=(const MatrixExpression&) = default;
+    ~MatrixExpression() = default;
+};
+
+/**
+ * @brief Elementwise operation on two matrices (sum or difference)
+ * @details When shapes don't match the result is the left matrix, as `lhs += rhs` leaves it untouched
+ *
+ */
+template<typename L, typename R, typename Operation>
+class MatrixBinaryExpression : public MatrixExpression<MatrixBinaryExpression<L, R, Operation>, typename L::ValueType> {
+public:
+    using ValueType = typename L::ValueType;
+
+    MatrixBinaryExpression(const L& lhs, const R& rhs) : mLhs(lhs), mRhs(rhs) {}
+
+    std::size_t getRows() const { return mLhs.getRows(); }
+    std::size_t getColumns() const { return mLhs.getColumns(); }
+
+    bool isConformable() const {
+        return isSameShape() && mLhs.isConformable() && mRhs.isConformable();
+    }
+
+    bool overlaps(const ValueType* begin, const ValueType* end) const {
+        return mLhs.overlaps(begin, end) || mRhs.overlaps(begin, end);
+    }
+
+    ValueType evaluate(std::size_t row, std::size_t column) const {
+        return Operation::apply(mLhs.evaluate(row, column), mRhs.evaluate(row, column));
+    }
+
+    ValueType get(std::size_t row, std::size_t column) const {
+        if (!isSameShape())
+            return mLhs.get(row, column);
+
+        return Operation::apply(mLhs.get(row, column), mRhs.get(row, column));
+    }
+
+private:
+    bool isSameShape() const {
+        return mLhs.getRows() == mRhs.getRows() && mLhs.getColumns() == mRhs.getColumns();
+    }
+
+    typename detail::ExpressionOperand<L>::Type mLhs;
+    typename detail::ExpressionOperand<R>::Type mRhs;
+};
+
+/**
+ * @brief Elementwise operation of matrix and number (multiplying or dividing)
+ *
+ */
+template<typename E, typename Operation>
+class MatrixScalarExpression : public MatrixExpression<MatrixScalarExpression<E, Operation>, typename E::ValueType> {
+public:
+    using ValueType = typename E::ValueType;
+
+    MatrixScalarExpression(const E& expression, const ValueType& value) : mExpression(expression), mValue(value) {}
+
+    std::size_t getRows() const { return mExpression.getRows(); }
+    std::size_t getColumns() const { return mExpression.getColumns(); }
+
+    bool isConformable() const { return mExpression.isConformable(); }
+
+    bool overlaps(const ValueType* begin, const ValueType* end) const { return mExpression.overlaps(begin, end); }
+
+    ValueType evaluate(std::size_t row, std::size_t column) const {
+        return Operation::apply(mExpression.evaluate(row, column), mValue);
+    }
+
+    ValueType get(std::size_t row, std::size_t column) const {
+        return Operation::apply(mExpression.get(row, column), mValue);
+    }
+
+private:
+    typename detail::ExpressionOperand<E>::Type mExpression;
+    ValueType mValue;
+};
+
+/**
+ * @brief Matrix with multiplied by -1 elements
+ *
+ */
+template<typename E>
+class MatrixNegateExpression : public MatrixExpression<MatrixNegateExpression<E>, typename E::ValueType> {
+public:
+    using ValueType = typename E::ValueType;
+
+    explicit MatrixNegateExpression(const E& expression) : mExpression(expression) {}
+
+    std::size_t getRows() const { return mExpression.getRows(); }
+    std::size_t getColumns() const { return mExpression.getColumns(); }
+
+    bool isConformable() const { return mExpression.isConformable(); }
+
+    bool overlaps(const ValueType* begin, const ValueType* end) const { return mExpression.overlaps(begin, end); }
+
+    ValueType evaluate(std::size_t row, std::size_t column) const {
+        return -mExpression.evaluate(row, column);
+    }
+
+    ValueType get(std::size_t row, std::size_t column) const {
+        return -mExpression.get(row, column);
+    }
+
+private:
+    typename detail::ExpressionOperand<E>::Type mExpression;
+};
+
+/**
+ * @brief Overloading for operator + (lazy sum of two matrices)
+ *
+ * @param lhs Left matrix
+ * @param rhs Right matrix
+ * @return MatrixBinaryExpression Lazy sum
+ */
+template<typename L, typename R, typename T>
+MatrixBinaryExpression<L, R, detail::AddOperation> operator+(const MatrixExpression<L, T>& lhs, const MatrixExpression<R, T>& rhs) {
+    return MatrixBinaryExpression<L, R, detail::AddOperation>(lhs.derived(), rhs.derived());
+}
+
+/**
+ * @brief Overloading for operator - (lazy difference of two matrices)
+ *
+ * @param lhs Left matrix
+ * @param rhs Right matrix
+ * @return MatrixBinaryExpression Lazy difference
+ */
+template<typename L, typename R, typename T>
+MatrixBinaryExpression<L, R, detail::SubtractOperation> operator-(const MatrixExpression<L, T>& lhs, const MatrixExpression<R, T>& rhs) {
+    return MatrixBinaryExpression<L, R, detail::SubtractOperation>(lhs.derived(), rhs.derived());
+}
+
+}
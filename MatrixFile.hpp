@@ -0,0 +1,509 @@
+/**
+ * @brief Binary matrix file format and memory mapping of files
+ *
+ * @file MatrixFile.hpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace MatrixCpp {
+namespace detail {
+
+/**
+ * @brief Header of matrix file, elements follow it at dataOffset row by row without gaps
+ * @details All fields are in byte order of the machine which wrote the file, byteOrder
+ * tells which one it was
+ *
+ */
+struct MatrixFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint32_t elementType;
+    std::uint32_t alignment;
+    std::uint64_t rows;
+    std::uint64_t columns;
+    std::uint64_t dataOffset;
+    std::uint8_t reserved[16];
+};
+
+static_assert(sizeof(MatrixFileHeader) == 64, "Header of matrix file must be 64 bytes");
+
+constexpr char MatrixFileMagic[8] = {'M', 'A', 'T', 'R', 'I', 'X', 'C', 'P'};
+constexpr std::uint32_t MatrixFileVersion = 1;
+constexpr std::uint32_t MatrixFileByteOrder = 0x01020304;
+constexpr std::uint32_t MatrixFileSwappedByteOrder = 0x04030201;
+
+/**
+ * @brief Data in files is aligned to a cache line, as in Matrix storage
+ *
+ */
+constexpr std::uint32_t MatrixFileAlignment = 64;
+
+/**
+ * @brief Code of element type stored in header: kind (1 float, 2 signed, 3 unsigned) << 8 | size
+ *
+ */
+template<typename T>
+constexpr std::uint32_t matrixFileElementType() {
+    static_assert(std::is_arithmetic<T>::value, "Only matrices of arithmetic types can be stored in files");
+    return (std::is_floating_point<T>::value ? 1u : std::is_signed<T>::value ? 2u : 3u) << 8 | sizeof(T);
+}
+
+template<typename T>
+T byteSwap(T value) {
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    for (std::size_t i = 0; i < sizeof(T) / 2; ++i)
+        std::swap(bytes[i], bytes[sizeof(T) - 1 - i]);
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+/**
+ * @brief Read-only file mapped into memory with copy-on-write pages
+ * @details Pages are read from the file on first access, writes go to private copies
+ * of pages and never reach the file
+ *
+ */
+class MappedFile {
+public:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+#ifdef _WIN32
+        UnmapViewOfFile(mData);
+#else
+        munmap(mData, mSize);
+#endif
+    }
+
+    /**
+     * @brief Map whole file
+     *
+     * @param path Path to file
+     * @return std::shared_ptr<MappedFile> Mapping (nullptr if file can't be mapped or is empty)
+     */
+    static std::shared_ptr<MappedFile> open(const std::string& path) {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return nullptr;
+
+        LARGE_INTEGER size;
+        void* data = nullptr;
+        if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+            if (mapping != nullptr) {
+                data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+
+        if (data == nullptr)
+            return nullptr;
+        return std::shared_ptr<MappedFile>(new MappedFile(data, static_cast<std::size_t>(size.QuadPart)));
+#else
+        int file = ::open(path.c_str(), O_RDONLY);
+        if (file < 0)
+            return nullptr;
+
+        struct stat status;
+        void* data = MAP_FAILED;
+        if (fstat(file, &status) == 0 && status.st_size > 0)
+            data = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+        ::close(file);
+
+        if (data == MAP_FAILED)
+            return nullptr;
+        return std::shared_ptr<MappedFile>(new MappedFile(data, static_cast<std::size_t>(status.st_size)));
+#endif
+    }
+
+    char* getData() const { return static_cast<char*>(mData); }
+    std::size_t getSize() const { return mSize; }
+
+private:
+    MappedFile(void* data, std::size_t size) : mData(data), mSize(size) {}
+
+    void* mData;
+    std::size_t mSize;
+};
+
+/**
+ * @brief Matrix file mapped into memory
+ *
+ * @tparam T Type of elements
+ */
+template<typename T>
+struct MappedMatrix {
+    std::shared_ptr<MappedFile> file;
+    T* data = nullptr;
+    std::size_t rows = 0;
+    std::size_t columns = 0;
+    bool swapped = false;
+};
+
+/**
+ * @brief Shape and placement of elements in matrix file
+ *
+ */
+struct MatrixFileLayout {
+    std::size_t rows = 0;
+    std::size_t columns = 0;
+    std::uint64_t dataOffset = 0;
+    bool swapped = false;
+};
+
+/**
+ * @brief Make header of file of rows x columns matrix of T
+ *
+ */
+template<typename T>
+MatrixFileHeader makeMatrixFileHeader(std::size_t rows, std::size_t columns) {
+    MatrixFileHeader header = {};
+    std::memcpy(header.magic, MatrixFileMagic, sizeof(header.magic));
+    header.version = MatrixFileVersion;
+    header.byteOrder = MatrixFileByteOrder;
+    header.elementType = matrixFileElementType<T>();
+    header.alignment = MatrixFileAlignment;
+    header.rows = rows;
+    header.columns = columns;
+    header.dataOffset = (sizeof(header) + MatrixFileAlignment - 1) / MatrixFileAlignment * MatrixFileAlignment;
+    return header;
+}
+
+/**
+ * @brief Validate header of matrix file
+ *
+ * @param header Header as it is in the file
+ * @param fileSize Size of the file in bytes
+ * @param layout Where elements are (if header is valid)
+ * @return bool Whether it's a valid file of matrix of T
+ */
+template<typename T>
+bool readMatrixFileHeader(MatrixFileHeader header, std::uint64_t fileSize, MatrixFileLayout& layout) {
+    if (std::memcmp(header.magic, MatrixFileMagic, sizeof(header.magic)) != 0)
+        return false;
+
+    bool swapped = header.byteOrder == MatrixFileSwappedByteOrder;
+    if (!swapped && header.byteOrder != MatrixFileByteOrder)
+        return false;
+
+    if (swapped) {
+        header.version = byteSwap(header.version);
+        header.elementType = byteSwap(header.elementType);
+        header.alignment = byteSwap(header.alignment);
+        header.rows = byteSwap(header.rows);
+        header.columns = byteSwap(header.columns);
+        header.dataOffset = byteSwap(header.dataOffset);
+    }
+
+    if (header.version != MatrixFileVersion || header.elementType != matrixFileElementType<T>())
+        return false;
+
+    // Data must be as aligned as the header says, mapped files are handed out as aligned
+    if (header.alignment == 0 || (header.alignment & (header.alignment - 1)) != 0
+            || header.dataOffset % header.alignment != 0)
+        return false;
+
+    // Sizes must fit in the file without overflowing
+    if (header.dataOffset % alignof(T) != 0 || header.dataOffset > fileSize
+            || (header.columns != 0 && header.rows > (fileSize - header.dataOffset) / sizeof(T) / header.columns))
+        return false;
+
+    layout.rows = static_cast<std::size_t>(header.rows);
+    layout.columns = static_cast<std::size_t>(header.columns);
+    layout.dataOffset = header.dataOffset;
+    layout.swapped = swapped;
+    return true;
+}
+
+/**
+ * @brief Map matrix file and validate its header
+ * @details If the file was written on a machine with other byte order, elements are
+ * still mapped as is and `swapped` is set
+ *
+ * @param path Path to file
+ * @return MappedMatrix<T> Mapped matrix (without file if it isn't a valid file of matrix of T)
+ */
+template<typename T>
+MappedMatrix<T> mapMatrixFile(const std::string& path) {
+    MappedMatrix<T> matrix;
+
+    std::shared_ptr<MappedFile> file = MappedFile::open(path);
+    if (!file || file->getSize() < sizeof(MatrixFileHeader))
+        return matrix;
+
+    MatrixFileHeader header;
+    std::memcpy(&header, file->getData(), sizeof(header));
+
+    MatrixFileLayout layout;
+    if (!readMatrixFileHeader<T>(header, file->getSize(), layout))
+        return matrix;
+
+    matrix.data = reinterpret_cast<T*>(file->getData() + layout.dataOffset);
+    matrix.rows = layout.rows;
+    matrix.columns = layout.columns;
+    matrix.swapped = layout.swapped;
+    matrix.file = std::move(file);
+    return matrix;
+}
+
+/**
+ * @brief Write matrix file
+ *
+ * @param path Path to file (replaced if exists)
+ * @param data Elements
+ * @param rows Number of rows
+ * @param columns Number of columns
+ * @param stride Distance between rows
+ * @return bool Whether the whole file was written
+ */
+template<typename T>
+bool writeMatrixFile(const std::string& path, const T* data, std::size_t rows, std::size_t columns, std::size_t stride) {
+    MatrixFileHeader header = makeMatrixFileHeader<T>(rows, columns);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        return false;
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (std::size_t padding = sizeof(header); padding < header.dataOffset; ++padding)
+        file.put('\0');
+
+    if (stride == columns) {
+        file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(rows * columns * sizeof(T)));
+    } else {
+        for (std::size_t row = 0; row < rows; ++row)
+            file.write(reinterpret_cast<const char*>(data + row * stride), static_cast<std::streamsize>(columns * sizeof(T)));
+    }
+
+    file.close();
+    return !file.fail();
+}
+
+/**
+ * @brief Matrix file opened for reading and writing blocks of elements at any position
+ * @details Reads and writes are positional, so different blocks can be transferred
+ * from different threads at the same time
+ *
+ * @tparam T Type of elements
+ */
+template<typename T>
+class MatrixFileStream {
+public:
+    MatrixFileStream(const MatrixFileStream&) = delete;
+    MatrixFileStream& operator=(const MatrixFileStream&) = delete;
+
+    ~MatrixFileStream() {
+        if (!isOpen())
+            return;
+#ifdef _WIN32
+        CloseHandle(mFile);
+#else
+        ::close(mFile);
+#endif
+    }
+
+    /**
+     * @brief Open existing matrix file for reading
+     *
+     * @param path Path to file
+     * @return std::unique_ptr<MatrixFileStream> Stream (nullptr if it isn't a valid file of matrix of T)
+     */
+    static std::unique_ptr<MatrixFileStream> open(const std::string& path) {
+        std::unique_ptr<MatrixFileStream> stream(new MatrixFileStream(openFile(path, false)));
+        if (!stream->isOpen())
+            return nullptr;
+
+        MatrixFileHeader header;
+        if (!stream->transfer(0, &header, sizeof(header), false)
+                || !readMatrixFileHeader<T>(header, stream->getFileSize(), stream->mLayout))
+            return nullptr;
+
+        return stream;
+    }
+
+    /**
+     * @brief Create matrix file of rows x columns elements (replaced if exists)
+     * @details Elements of the new file are zeros
+     *
+     * @param path Path to file
+     * @param rows Number of rows
+     * @param columns Number of columns
+     * @return std::unique_ptr<MatrixFileStream> Stream (nullptr if the file can't be created)
+     */
+    static std::unique_ptr<MatrixFileStream> create(const std::string& path, std::size_t rows, std::size_t columns) {
+        std::unique_ptr<MatrixFileStream> stream(new MatrixFileStream(openFile(path, true)));
+        if (!stream->isOpen())
+            return nullptr;
+
+        MatrixFileHeader header = makeMatrixFileHeader<T>(rows, columns);
+        stream->mLayout.rows = rows;
+        stream->mLayout.columns = columns;
+        stream->mLayout.dataOffset = header.dataOffset;
+
+        if (!stream->transfer(0, &header, sizeof(header), true)
+                || !stream->resize(header.dataOffset + static_cast<std::uint64_t>(rows) * columns * sizeof(T)))
+            return nullptr;
+
+        return stream;
+    }
+
+    std::size_t getRows() const { return mLayout.rows; }
+    std::size_t getColumns() const { return mLayout.columns; }
+
+    /**
+     * @brief Read block of elements
+     *
+     * @param row First row of block
+     * @param column First column of block
+     * @param rows Number of rows of block
+     * @param columns Number of columns of block
+     * @param destination Where to put elements
+     * @param stride Distance between rows of destination
+     * @return bool Whether the whole block was read
+     */
+    bool readBlock(std::size_t row, std::size_t column, std::size_t rows, std::size_t columns, T* destination, std::size_t stride) {
+        for (std::size_t i = 0; i < rows; ++i) {
+            T* target = destination + i * stride;
+            if (!transfer(getOffset(row + i, column), target, columns * sizeof(T), false))
+                return false;
+
+            if (mLayout.swapped) {
+                for (std::size_t j = 0; j < columns; ++j)
+                    target[j] = byteSwap(target[j]);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Write block of elements
+     *
+     * @param row First row of block
+     * @param column First column of block
+     * @param rows Number of rows of block
+     * @param columns Number of columns of block
+     * @param source Elements
+     * @param stride Distance between rows of source
+     * @return bool Whether the whole block was written
+     */
+    bool writeBlock(std::size_t row, std::size_t column, std::size_t rows, std::size_t columns, const T* source, std::size_t stride) {
+        for (std::size_t i = 0; i < rows; ++i) {
+            if (!transfer(getOffset(row + i, column), const_cast<T*>(source + i * stride), columns * sizeof(T), true))
+                return false;
+        }
+        return true;
+    }
+
+private:
+#ifdef _WIN32
+    using Handle = HANDLE;
+#else
+    using Handle = int;
+#endif
+
+    explicit MatrixFileStream(Handle file) : mFile(file) {}
+
+    static Handle openFile(const std::string& path, bool create) {
+#ifdef _WIN32
+        return CreateFileA(path.c_str(), create ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           create ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+#else
+        return create ? ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644) : ::open(path.c_str(), O_RDONLY);
+#endif
+    }
+
+    bool isOpen() const {
+#ifdef _WIN32
+        return mFile != INVALID_HANDLE_VALUE;
+#else
+        return mFile >= 0;
+#endif
+    }
+
+    std::uint64_t getFileSize() const {
+#ifdef _WIN32
+        LARGE_INTEGER size;
+        return GetFileSizeEx(mFile, &size) ? static_cast<std::uint64_t>(size.QuadPart) : 0;
+#else
+        struct stat status;
+        return fstat(mFile, &status) == 0 ? static_cast<std::uint64_t>(status.st_size) : 0;
+#endif
+    }
+
+    bool resize(std::uint64_t size) {
+#ifdef _WIN32
+        LARGE_INTEGER position;
+        position.QuadPart = static_cast<LONGLONG>(size);
+        return SetFilePointerEx(mFile, position, nullptr, FILE_BEGIN) && SetEndOfFile(mFile);
+#else
+        return ftruncate(mFile, static_cast<off_t>(size)) == 0;
+#endif
+    }
+
+    std::uint64_t getOffset(std::size_t row, std::size_t column) const {
+        return mLayout.dataOffset + (static_cast<std::uint64_t>(row) * mLayout.columns + column) * sizeof(T);
+    }
+
+    /**
+     * @brief Read or write bytes at offset, continuing after partial transfers
+     *
+     */
+    bool transfer(std::uint64_t offset, void* data, std::size_t bytes, bool write) {
+        char* position = static_cast<char*>(data);
+        while (bytes > 0) {
+#ifdef _WIN32
+            OVERLAPPED overlapped = {};
+            overlapped.Offset = static_cast<DWORD>(offset);
+            overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+            DWORD chunk = static_cast<DWORD>(std::min<std::size_t>(bytes, 1u << 30)), done = 0;
+            if (!(write ? WriteFile(mFile, position, chunk, &done, &overlapped) : ReadFile(mFile, position, chunk, &done, &overlapped)) || done == 0)
+                return false;
+#else
+            ssize_t done = write ? pwrite(mFile, position, bytes, static_cast<off_t>(offset))
+                                 : pread(mFile, position, bytes, static_cast<off_t>(offset));
+            if (done <= 0)
+                return false;
+#endif
+            position += done;
+            offset += static_cast<std::uint64_t>(done);
+            bytes -= static_cast<std::size_t>(done);
+        }
+        return true;
+    }
+
+    Handle mFile;
+    MatrixFileLayout mLayout;
+};
+
+}
+}
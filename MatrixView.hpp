@@ -0,0 +1,319 @@
+/**
+ * @brief Non-owning views of rows, columns, diagonals and blocks of matrix
+ *
+ * @file MatrixView.hpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include "MatrixExpression.hpp"
+#include "Simd.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace MatrixCpp {
+
+/**
+ * @brief Non-owning view of elements placed with a constant stride (row, column or diagonal)
+ * @details Doesn't copy anything, writes go straight to the matrix. The view is valid
+ * while the matrix is alive and isn't resized.
+ *
+ * @tparam T Type of elements (const-qualified for read-only views)
+ */
+template<typename T>
+class VectorView {
+public:
+    using value_type = typename std::remove_const<T>::type;
+
+    /**
+     * @brief Random access iterator over strided elements
+     *
+     */
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename std::remove_const<T>::type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() : mPointer(nullptr), mStride(1) {}
+        iterator(T* pointer, std::ptrdiff_t stride) : mPointer(pointer), mStride(stride) {}
+
+        T& operator*() const { return *mPointer; }
+        T* operator->() const { return mPointer; }
+        T& operator[](difference_type n) const { return mPointer[n * mStride]; }
+
+        iterator& operator++() { mPointer += mStride; return *this; }
+        iterator& operator--() { mPointer -= mStride; return *this; }
+        iterator operator++(int) { iterator it = *this; mPointer += mStride; return it; }
+        iterator operator--(int) { iterator it = *this; mPointer -= mStride; return it; }
+        iterator& operator+=(difference_type n) { mPointer += n * mStride; return *this; }
+        iterator& operator-=(difference_type n) { mPointer -= n * mStride; return *this; }
+        iterator operator+(difference_type n) const { return iterator(mPointer + n * mStride, mStride); }
+        iterator operator-(difference_type n) const { return iterator(mPointer - n * mStride, mStride); }
+        friend iterator operator+(difference_type n, const iterator& it) { return it + n; }
+        difference_type operator-(const iterator& rhs) const { return (mPointer - rhs.mPointer) / mStride; }
+
+        bool operator==(const iterator& rhs) const { return mPointer == rhs.mPointer; }
+        bool operator!=(const iterator& rhs) const { return mPointer != rhs.mPointer; }
+        bool operator<(const iterator& rhs) const { return (rhs.mPointer - mPointer) * mStride > 0; }
+        bool operator>(const iterator& rhs) const { return rhs < *this; }
+        bool operator<=(const iterator& rhs) const { return !(rhs < *this); }
+        bool operator>=(const iterator& rhs) const { return !(*this < rhs); }
+
+    private:
+        T* mPointer;
+        std::ptrdiff_t mStride;
+    };
+
+    /**
+     * @brief Construct a new VectorView object
+     *
+     * @param data Pointer to the first element
+     * @param size Number of elements
+     * @param stride Distance (in elements) between neighbour elements
+     */
+    VectorView(T* data, std::size_t size, std::ptrdiff_t stride = 1) : mData(data), mSize(size), mStride(stride) {}
+
+    /**
+     * @brief Read-only view of read-write view
+     *
+     */
+    template<typename U, typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+    VectorView(const VectorView<U>& view) : mData(view.getData()), mSize(view.size()), mStride(view.getStride()) {}
+
+    /**
+     * @brief Get number of elements
+     *
+     * @return std::size_t Number of elements
+     */
+    std::size_t size() const { return mSize; }
+
+    /**
+     * @brief Get distance (in elements) between neighbour elements
+     *
+     * @return std::ptrdiff_t Stride
+     */
+    std::ptrdiff_t getStride() const { return mStride; }
+
+    /**
+     * @brief Get pointer to the first element
+     *
+     * @return T* Pointer
+     */
+    T* getData() const { return mData; }
+
+    /**
+     * @brief Access to element
+     *
+     * @param index Index of element
+     * @return T& Element
+     */
+    T& operator[](std::size_t index) const { return mData[static_cast<std::ptrdiff_t>(index) * mStride]; }
+
+    iterator begin() const { return iterator(mData, mStride); }
+    iterator end() const { return iterator(mData + static_cast<std::ptrdiff_t>(mSize) * mStride, mStride); }
+
+    /**
+     * @brief Copies elements into a std::vector (for code which expects it)
+     *
+     * @return std::vector<value_type> Elements
+     */
+    operator std::vector<value_type>() const {
+        return std::vector<value_type>(begin(), end());
+    }
+
+private:
+    T* mData;
+    std::size_t mSize;
+    std::ptrdiff_t mStride;
+};
+
+/**
+ * @brief View of one row of matrix (contiguous)
+ *
+ */
+template<typename T>
+using RowView = VectorView<T>;
+
+/**
+ * @brief View of one column of matrix (stride is the stride of matrix)
+ *
+ */
+template<typename T>
+using ColumnView = VectorView<T>;
+
+/**
+ * @brief View of main diagonal of matrix (stride is the stride of matrix + 1)
+ *
+ */
+template<typename T>
+using DiagonalView = VectorView<T>;
+
+/**
+ * @brief Non-owning view of rectangular block of matrix
+ * @details Works everywhere a matrix expression is expected (arithmetic, Matrix constructor,
+ * LUDecomposition, Determinant) and can be modified in place, so block algorithms don't
+ * need copies. The view is valid while the matrix is alive and isn't resized.
+ * An expression which reads memory of the block (e.g. an overlapping block of the same matrix)
+ * is evaluated into a temporary before it's assigned.
+ *
+ * @tparam T Type of elements (const-qualified for read-only views)
+ */
+template<typename T>
+class SubMatrixView : public MatrixExpression<SubMatrixView<T>, typename std::remove_const<T>::type> {
+public:
+    using ValueType = typename std::remove_const<T>::type;
+
+    /**
+     * @brief Construct a new SubMatrixView object
+     *
+     * @param data Pointer to the top left element
+     * @param rows Number of rows
+     * @param columns Number of columns
+     * @param stride Distance (in elements) between starts of neighbour rows
+     */
+    SubMatrixView(T* data, std::size_t rows, std::size_t columns, std::size_t stride)
+        : mData(data), mRows(rows), mColumns(columns), mStride(stride) {}
+
+    SubMatrixView(const SubMatrixView& view) = default;
+
+    /**
+     * @brief Read-only view of read-write view
+     *
+     */
+    template<typename U, typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+    SubMatrixView(const SubMatrixView<U>& view)
+        : mData(view.getData()), mRows(view.getRows()), mColumns(view.getColumns()), mStride(view.getStride()) {}
+
+    /**
+     * @brief Copies elements of other view into this block (sizes must match)
+     *
+     * @param view View to copy
+     * @return SubMatrixView& This view
+     */
+    SubMatrixView& operator=(const SubMatrixView& view) {
+        return *this = static_cast<const MatrixExpression<SubMatrixView, ValueType>&>(view);
+    }
+
+    /**
+     * @brief Evaluates expression into this block (nothing happens if sizes don't match)
+     *
+     * @param expression Expression
+     * @return SubMatrixView& This view
+     */
+    template<typename E>
+    SubMatrixView& operator=(const MatrixExpression<E, ValueType>& expression) {
+        assignExpression(expression.derived(), [](T&, const ValueType& value) { return value; });
+        return *this;
+    }
+
+    template<typename E>
+    SubMatrixView& operator+=(const MatrixExpression<E, ValueType>& expression) {
+        assignExpression(expression.derived(), [](T& el, const ValueType& value) { return el + value; });
+        return *this;
+    }
+
+    template<typename E>
+    SubMatrixView& operator-=(const MatrixExpression<E, ValueType>& expression) {
+        assignExpression(expression.derived(), [](T& el, const ValueType& value) { return el - value; });
+        return *this;
+    }
+
+    SubMatrixView& operator*=(const ValueType& value) {
+        const detail::ElementwiseKernels<ValueType>& kernels = detail::getElementwiseKernels<ValueType>();
+        for (std::size_t row = 0; row < mRows; ++row)
+            kernels.multiply(mData + row * mStride, value, mColumns);
+        return *this;
+    }
+
+    SubMatrixView& operator/=(const ValueType& value) {
+        const detail::ElementwiseKernels<ValueType>& kernels = detail::getElementwiseKernels<ValueType>();
+        for (std::size_t row = 0; row < mRows; ++row)
+            kernels.divide(mData + row * mStride, value, mColumns);
+        return *this;
+    }
+
+    std::size_t getRows() const { return mRows; }
+    std::size_t getColumns() const { return mColumns; }
+    std::size_t getStride() const { return mStride; }
+    T* getData() const { return mData; }
+
+    ValueType get(std::size_t row, std::size_t column) const { return mData[row * mStride + column]; }
+    void set(std::size_t row, std::size_t column, ValueType value) const { mData[row * mStride + column] = value; }
+
+    ValueType evaluate(std::size_t row, std::size_t column) const { return mData[row * mStride + column]; }
+    bool isConformable() const { return true; }
+
+    bool overlaps(const ValueType* begin, const ValueType* end) const {
+        return detail::overlapsBlock(static_cast<const ValueType*>(mData), mRows, mColumns, mStride, begin, end);
+    }
+
+    RowView<T> operator[](std::size_t row) const { return RowView<T>(mData + row * mStride, mColumns); }
+
+    RowView<T> getRow(std::size_t row) const {
+        return RowView<T>(mData + row * mStride, mColumns);
+    }
+
+    ColumnView<T> getColumn(std::size_t column) const {
+        return ColumnView<T>(mData + column, mRows, static_cast<std::ptrdiff_t>(mStride));
+    }
+
+    DiagonalView<T> getDiagonal() const {
+        return DiagonalView<T>(mData, std::min(mRows, mColumns), static_cast<std::ptrdiff_t>(mStride) + 1);
+    }
+
+    SubMatrixView getSubMatrix(std::size_t row, std::size_t column, std::size_t rows, std::size_t columns) const {
+        return SubMatrixView(mData + row * mStride + column, rows, columns, mStride);
+    }
+
+private:
+    template<typename E, typename Operation>
+    void assignExpression(const E& expression, Operation operation) {
+        if (expression.getRows() != mRows || expression.getColumns() != mColumns || mRows == 0 || mColumns == 0)
+            return;
+
+        // Writing rows in place would change elements which the expression hasn't read yet
+        if (expression.overlaps(mData, mData + (mRows - 1) * mStride + mColumns)) {
+            detail::ScratchBuffer<ValueType> values(mRows * mColumns);
+            for (std::size_t row = 0; row < mRows; ++row)
+                for (std::size_t column = 0; column < mColumns; ++column)
+                    values[row * mColumns + column] = expression.get(row, column);
+
+            for (std::size_t row = 0; row < mRows; ++row) {
+                T* data = mData + row * mStride;
+                for (std::size_t column = 0; column < mColumns; ++column)
+                    data[column] = operation(data[column], values[row * mColumns + column]);
+            }
+            return;
+        }
+
+        if (expression.isConformable()) {
+            for (std::size_t row = 0; row < mRows; ++row) {
+                T* data = mData + row * mStride;
+                for (std::size_t column = 0; column < mColumns; ++column)
+                    data[column] = operation(data[column], expression.evaluate(row, column));
+            }
+        } else {
+            for (std::size_t row = 0; row < mRows; ++row) {
+                T* data = mData + row * mStride;
+                for (std::size_t column = 0; column < mColumns; ++column)
+                    data[column] = operation(data[column], expression.get(row, column));
+            }
+        }
+    }
+
+    T* mData;
+    std::size_t mRows;
+    std::size_t mColumns;
+    std::size_t mStride;
+};
+
+}
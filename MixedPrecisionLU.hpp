@@ -0,0 +1,415 @@
+/**
+ * @brief LU decomposition in lower precision with iterative refinement
+ *
+ * @file MixedPrecisionLU.hpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include "LUDecomposition.hpp"
+#include "Matrix.hpp"
+#include "Multiply.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace MatrixCpp {
+
+namespace detail {
+
+/**
+ * @brief Refinement gives up after this many steps and the matrix is factored in full precision
+ * @details Same limit as LAPACK's dsgesv. Each step gains about log10(1 / (cond(A) * eps of float))
+ * digits, so well-conditioned systems converge in 2-3 steps.
+ *
+ */
+constexpr std::size_t MixedPrecisionMaxIterations = 30;
+
+/**
+ * @brief Factor by which every refinement step has to reduce the largest residual
+ * @details A step which reduces it less means cond(A) is close to 1 / eps of Low, so the matrix
+ * is factored in full precision right away instead of spending the remaining steps.
+ *
+ */
+constexpr double MixedPrecisionMinReduction = 0.5;
+
+/**
+ * @brief Copies matrix into matrix of another type of elements
+ *
+ * @return bool Whether every element fits into the range of To (false for infinities and NaN)
+ */
+template<typename To, typename From>
+bool convertMatrix(const Matrix<From>& source, Matrix<To>& target) {
+    if (target.getRows() != source.getRows() || target.getColumns() != source.getColumns())
+        target = Matrix<To>(source.getRows(), source.getColumns());
+
+    const From limit = static_cast<From>(std::numeric_limits<To>::max());
+    bool fits = true;
+
+    for (std::size_t row = 0; row < source.getRows(); ++row) {
+        const From* from = source.getData() + row * source.getStride();
+        To* to = target.getData() + row * target.getStride();
+        for (std::size_t column = 0; column < source.getColumns(); ++column) {
+            fits &= magnitude(from[column]) <= limit;
+            to[column] = static_cast<To>(from[column]);
+        }
+    }
+
+    return fits;
+}
+
+}
+
+/**
+ * @brief Solver which factors the matrix in lower precision and refines solutions in full precision
+ * @details The LU decomposition is computed in Low (float by default), which has twice as many
+ * elements in a SIMD register and half the memory traffic of double. Every solution is then
+ * improved by iterative refinement: the residual r = b - A * x is computed in T and the correction
+ * is solved with the low precision factors, until the residual is at the level of rounding errors of T.
+ * When the matrix doesn't fit into Low, its factors are singular or refinement doesn't converge
+ * (cond(A) is about 1 / eps of Low or worse), the matrix is factored in T and solved directly from then on.
+ * The gain is smaller than the register width suggests: mixed_lu_solve of bench/MatrixBenchmark.cpp on one
+ * AVX-512 x86 core is 8% slower than lu_decompose in double at 256, 1.2x faster at 1024 and 1.4x at 2048,
+ * because pivoting, the copy of the matrix and the residuals (a double product per step) don't shrink.
+ * Like LUDecomposition, solve() is const and may be called from several threads at once:
+ * the factorization in T is made once under a lock by the first solve which needs it.
+ *
+ * @tparam T Type of matrix's elements
+ * @tparam Low Type in which matrix is factored
+ */
+template<typename T, typename Low = float>
+class MixedPrecisionLUDecomposition {
+    static_assert(std::is_floating_point<T>::value && std::is_floating_point<Low>::value,
+                  "Mixed precision decomposition needs floating point types");
+
+public:
+    /**
+     * @brief Construct a new empty MixedPrecisionLUDecomposition object
+     *
+     */
+    MixedPrecisionLUDecomposition();
+
+    /**
+     * @brief Construct a new MixedPrecisionLUDecomposition object with decomposition of given matrix
+     *
+     * @param matrix Matrix to get decomposition
+     */
+    MixedPrecisionLUDecomposition(const Matrix<T>& matrix);
+
+    MixedPrecisionLUDecomposition(const MixedPrecisionLUDecomposition& decomposition);
+    MixedPrecisionLUDecomposition& operator=(const MixedPrecisionLUDecomposition& decomposition);
+
+    /**
+     * @brief Decomposes given matrix (keeps a copy of it for residuals)
+     *
+     * @param matrix Matrix to get decomposition
+     * @return true if decomposition was successfully gotten
+     * @return false if decomposition wasn't gotten (matrix isn't square)
+     */
+    bool decompose(const Matrix<T>& matrix);
+
+    /**
+     * @brief Check is decomposition empty or not (empty when given matrix isn't square)
+     *
+     * @return bool Is empty
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Check is decomposed matrix singular (in full precision)
+     *
+     * @return bool Is singular
+     */
+    bool isSingular() const;
+
+    /**
+     * @brief Check whether solutions come from the low precision factors (false after falling back to T)
+     *
+     * @return bool Are low precision factors used
+     */
+    bool isMixedPrecision() const;
+
+    /**
+     * @brief Get the size of decomposed matrix (Size x Size)
+     *
+     * @return std::size_t Size
+     */
+    std::size_t getSize() const;
+
+    /**
+     * @brief Solves A * x = b to the accuracy of T
+     * @details If refinement doesn't converge, the matrix is factored in T and
+     * this factorization is kept for the next solves
+     *
+     * @param b Right-hand side
+     * @return std::vector<T> Solution (empty if sizes don't fit or matrix is singular)
+     */
+    std::vector<T> solve(const std::vector<T>& b) const;
+
+    /**
+     * @brief Solves A * X = B for all columns of B at once to the accuracy of T
+     *
+     * @param B Right-hand sides
+     * @return Matrix<T> Solutions (empty if sizes don't fit or matrix is singular)
+     */
+    Matrix<T> solve(const Matrix<T>& B) const;
+
+    /**
+     * @brief Solves A * X = B and reports how many refinement steps it took
+     *
+     * @param B Right-hand sides
+     * @param iterations Gets number of steps (0 if the first low precision solution was already accurate
+     * or the matrix was already factored in T)
+     * @return Matrix<T> Solutions (empty if sizes don't fit or matrix is singular)
+     */
+    Matrix<T> solve(const Matrix<T>& B, std::size_t& iterations) const;
+
+private:
+    /**
+     * @brief Factors the matrix in T (once) and stops using low precision factors
+     *
+     */
+    void fallBack() const;
+
+    /**
+     * @brief Copy of decomposed matrix
+     *
+     */
+    Matrix<T> matrix;
+
+    /**
+     * @brief Factors in low precision
+     *
+     */
+    LUDecomposition<Low> low;
+
+    /**
+     * @brief Factors in full precision (only after falling back, never changed by solves after that)
+     *
+     */
+    mutable LUDecomposition<T> full;
+
+    /**
+     * @brief Sets to true, when full is ready (published with release order)
+     *
+     */
+    mutable std::atomic<bool> fullPrecision;
+
+    /**
+     * @brief Makes concurrent solves factor the matrix in T only once
+     *
+     */
+    mutable std::mutex fallBackMutex;
+
+    /**
+     * @brief Maximum absolute row sum of the matrix
+     *
+     */
+    T norm;
+
+    /**
+     * @brief Sets to true, if decomposition wasn't gotten
+     *
+     */
+    bool empty;
+};
+
+template<typename T, typename Low>
+MixedPrecisionLUDecomposition<T, Low>::MixedPrecisionLUDecomposition() : fullPrecision(false) {
+    norm = T();
+    empty = true;
+}
+
+template<typename T, typename Low>
+MixedPrecisionLUDecomposition<T, Low>::MixedPrecisionLUDecomposition(const Matrix<T>& matrix) : fullPrecision(false) {
+    decompose(matrix);
+}
+
+template<typename T, typename Low>
+MixedPrecisionLUDecomposition<T, Low>::MixedPrecisionLUDecomposition(const MixedPrecisionLUDecomposition& decomposition)
+        : fullPrecision(false) {
+    *this = decomposition;
+}
+
+template<typename T, typename Low>
+MixedPrecisionLUDecomposition<T, Low>&
+MixedPrecisionLUDecomposition<T, Low>::operator=(const MixedPrecisionLUDecomposition& decomposition) {
+    if (this == &decomposition)
+        return *this;
+
+    // Another thread may be falling back in decomposition right now
+    std::lock_guard<std::mutex> lock(decomposition.fallBackMutex);
+    matrix = decomposition.matrix;
+    low = decomposition.low;
+    full = decomposition.full;
+    fullPrecision.store(decomposition.fullPrecision.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    norm = decomposition.norm;
+    empty = decomposition.empty;
+    return *this;
+}
+
+template<typename T, typename Low>
+bool MixedPrecisionLUDecomposition<T, Low>::decompose(const Matrix<T>& source) {
+    norm = T();
+    low = LUDecomposition<Low>();
+    full = LUDecomposition<T>();
+    fullPrecision.store(false, std::memory_order_relaxed);
+
+    if (source.getRows() != source.getColumns()) {
+        matrix = Matrix<T>();
+        empty = true;
+        return !empty;
+    }
+
+    matrix = source;
+    empty = false;
+
+    for (std::size_t row = 0; row < matrix.getRows(); ++row) {
+        const T* data = matrix.getData() + row * matrix.getStride();
+        T sum = T();
+        for (std::size_t column = 0; column < matrix.getColumns(); ++column)
+            sum += detail::magnitude(data[column]);
+        norm = std::max(norm, sum);
+    }
+
+    Matrix<Low> converted;
+    if (!detail::convertMatrix(matrix, converted)) {
+        fallBack();
+        return !empty;
+    }
+
+    low.decompose(converted);
+
+    // Rounding to Low may make a nearly singular matrix exactly singular
+    if (low.isSingular()) {
+        fallBack();
+        low = LUDecomposition<Low>();
+    }
+
+    return !empty;
+}
+
+template<typename T, typename Low>
+bool MixedPrecisionLUDecomposition<T, Low>::isEmpty() const {
+    return empty;
+}
+
+template<typename T, typename Low>
+bool MixedPrecisionLUDecomposition<T, Low>::isSingular() const {
+    return fullPrecision.load(std::memory_order_acquire) && full.isSingular();
+}
+
+template<typename T, typename Low>
+bool MixedPrecisionLUDecomposition<T, Low>::isMixedPrecision() const {
+    return !empty && !fullPrecision.load(std::memory_order_acquire);
+}
+
+template<typename T, typename Low>
+std::size_t MixedPrecisionLUDecomposition<T, Low>::getSize() const {
+    return matrix.getRows();
+}
+
+template<typename T, typename Low>
+std::vector<T> MixedPrecisionLUDecomposition<T, Low>::solve(const std::vector<T>& b) const {
+    if (empty || b.size() != getSize())
+        return std::vector<T>();
+
+    Matrix<T> B(b.size(), 1);
+    std::copy(b.begin(), b.end(), B.getData());
+
+    Matrix<T> X = solve(B);
+    return std::vector<T>(X.getData(), X.getData() + X.getRows());
+}
+
+template<typename T, typename Low>
+Matrix<T> MixedPrecisionLUDecomposition<T, Low>::solve(const Matrix<T>& B) const {
+    std::size_t iterations = 0;
+    return solve(B, iterations);
+}
+
+template<typename T, typename Low>
+Matrix<T> MixedPrecisionLUDecomposition<T, Low>::solve(const Matrix<T>& B, std::size_t& iterations) const {
+    iterations = 0;
+
+    if (empty || B.getRows() != getSize())
+        return Matrix<T>();
+
+    if (fullPrecision.load(std::memory_order_acquire))
+        return full.solve(B);
+
+    const std::size_t size = getSize(), columns = B.getColumns();
+    const T tolerance = norm * std::numeric_limits<T>::epsilon() * std::sqrt(static_cast<T>(size));
+
+    Matrix<Low> lowB;
+    Matrix<T> X, residual(size, columns);
+
+    if (!detail::convertMatrix(B, lowB)) {
+        fallBack();
+        return full.solve(B);
+    }
+    detail::convertMatrix(low.solve(lowB), X);
+
+    T previousNorm = std::numeric_limits<T>::infinity();
+
+    for (;;) {
+        // residual = B - A * X in full precision
+        detail::multiply<T>(size, columns, size, matrix.getData(), matrix.getStride(), X.getData(), X.getStride(),
+                            residual.getData(), residual.getStride());
+
+        bool converged = true;
+        T worstNorm = T();
+        for (std::size_t column = 0; column < columns; ++column) {
+            T residualNorm = T(), solutionNorm = T();
+            for (std::size_t row = 0; row < size; ++row) {
+                T& r = residual.getData()[row * residual.getStride() + column];
+                r = B.getData()[row * B.getStride() + column] - r;
+                residualNorm = std::max(residualNorm, detail::magnitude(r));
+                solutionNorm = std::max(solutionNorm, detail::magnitude(X.getData()[row * X.getStride() + column]));
+            }
+            // Negated comparison also catches NaN
+            if (!(residualNorm <= solutionNorm * tolerance))
+                converged = false;
+            worstNorm = std::max(worstNorm, residualNorm);
+        }
+
+        if (converged)
+            return X;
+
+        // Refinement which doesn't at least halve the residual has stalled, so the remaining steps
+        // would be wasted before falling back anyway
+        if (!(worstNorm < previousNorm * static_cast<T>(detail::MixedPrecisionMinReduction)))
+            break;
+        previousNorm = worstNorm;
+
+        if (iterations == detail::MixedPrecisionMaxIterations || !detail::convertMatrix(residual, lowB))
+            break;
+
+        ++iterations;
+        detail::convertMatrix(low.solve(lowB), residual);
+        X += residual;
+    }
+
+    fallBack();
+    return full.solve(B);
+}
+
+template<typename T, typename Low>
+void MixedPrecisionLUDecomposition<T, Low>::fallBack() const {
+    std::lock_guard<std::mutex> lock(fallBackMutex);
+    if (fullPrecision.load(std::memory_order_relaxed))
+        return;
+
+    // Low precision factors stay: other threads may still be refining with them
+    full.decompose(matrix);
+    fullPrecision.store(true, std::memory_order_release);
+}
+
+}
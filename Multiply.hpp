@@ -0,0 +1,62 @@
+/**
+ * @brief Choice of kernel for dense products
+ *
+ * @file Multiply.hpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include "Allocator.hpp"
+#include "Gemm.hpp"
+#include "Gemv.hpp"
+#include "Strassen.hpp"
+
+#include <atomic>
+#include <cstddef>
+
+namespace MatrixCpp {
+namespace detail {
+
+/**
+ * @brief C = A * B for row-major operands
+ * @details Products with a vector go to gemv (column vector on the right) or gevm (row vector on the left),
+ * big square products to Strassen-Winograd recursion and everything else to gemm
+ *
+ */
+template<typename T>
+void multiply(std::size_t m, std::size_t n, std::size_t k, const T* a, std::size_t strideA, const T* b, std::size_t strideB,
+              T* c, std::size_t strideC) {
+    if (n == 1) {
+        if (strideB == 1 || k < 2) {
+            gemv(m, k, a, strideA, b, c, strideC);
+            return;
+        }
+
+        // Column of a bigger matrix: gather it so the dot products read contiguous memory
+        ScratchBuffer<T> x(k);
+        for (std::size_t i = 0; i < k; ++i)
+            x.data()[i] = b[i * strideB];
+        gemv(m, k, a, strideA, x.data(), c, strideC);
+        return;
+    }
+
+    if (m == 1) {
+        gevm(k, n, a, b, strideB, c);
+        return;
+    }
+
+    std::size_t crossover = getStrassenCrossoverSetting().load(std::memory_order_relaxed);
+
+    if (crossover != 0 && m == n && n == k && n >= crossover) {
+        strassen(m, n, k, T(1), a, strideA, b, strideB, T(), c, strideC, crossover);
+        return;
+    }
+
+    gemm(m, n, k, T(1), a, static_cast<std::ptrdiff_t>(strideA), 1, b, static_cast<std::ptrdiff_t>(strideB), 1,
+         T(), c, static_cast<std::ptrdiff_t>(strideC), 1);
+}
+
+}
+}
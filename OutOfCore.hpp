@@ -0,0 +1,248 @@
+/**
+ * @brief Multiplying matrices which don't fit in memory, tile by tile from files
+ *
+ * @file OutOfCore.hpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include "Allocator.hpp"
+#include "Gemm.hpp"
+#include "Matrix.hpp"
+#include "MatrixFile.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace MatrixCpp {
+
+namespace detail {
+
+/**
+ * @brief Tiles bigger than this are rounded down to a multiple of it, so GEMM blocks stay whole
+ *
+ */
+constexpr std::size_t OutOfCoreTileAlignment = 64;
+
+/**
+ * @brief Number of tile buffers: two (current and prefetched) for each operand and result
+ *
+ */
+constexpr std::size_t OutOfCoreTileBuffers = 6;
+
+/**
+ * @brief Memory which multiplying files with square tiles of given size takes: tile buffers
+ * plus packing buffers of GEMM in scratch arenas of all threads
+ *
+ */
+template<typename T>
+std::size_t getOutOfCoreFootprint(std::size_t tile) {
+    using Blocking = GemmBlocking<T>;
+
+    const std::size_t line = std::max<std::size_t>(1, ScratchArena::Alignment / sizeof(T));
+    const std::size_t stride = (tile + line - 1) / line * line;
+    const std::size_t depth = std::min(Blocking::KC, tile);
+    const std::size_t packing = (std::min(Blocking::MC, tile + Blocking::MR) + std::min(Blocking::NC, tile + Blocking::NR)) * depth
+        + 2 * line;
+
+    return (OutOfCoreTileBuffers * tile * stride + packing * getThreadCount()) * sizeof(T);
+}
+
+/**
+ * @brief Thread which runs one task at a time in background
+ * @details Reads and writes of all tiles go through one such thread, so no thread is created per tile
+ *
+ */
+class OutOfCoreWorker {
+public:
+    OutOfCoreWorker() : mHasTask(false), mDone(false), mResult(false), mStop(false) {
+        mThread = std::thread([this] { work(); });
+    }
+
+    ~OutOfCoreWorker() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+        }
+        mWakeUp.notify_all();
+        mThread.join();
+    }
+
+    OutOfCoreWorker(const OutOfCoreWorker&) = delete;
+    OutOfCoreWorker& operator=(const OutOfCoreWorker&) = delete;
+
+    /**
+     * @brief Start task (the previous one must be waited for)
+     *
+     */
+    void start(std::function<bool()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mTask = std::move(task);
+            mHasTask = true;
+            mDone = false;
+        }
+        mWakeUp.notify_all();
+    }
+
+    /**
+     * @brief Wait for started task
+     *
+     * @return bool Result of task
+     */
+    bool wait() {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mWakeUp.wait(lock, [this] { return mDone; });
+        return mResult;
+    }
+
+private:
+    void work() {
+        std::unique_lock<std::mutex> lock(mMutex);
+
+        while (true) {
+            mWakeUp.wait(lock, [this] { return mHasTask || mStop; });
+            if (!mHasTask)
+                return;
+
+            std::function<bool()> task = std::move(mTask);
+            mHasTask = false;
+
+            lock.unlock();
+            bool result = task();
+            lock.lock();
+
+            mResult = result;
+            mDone = true;
+            mWakeUp.notify_all();
+        }
+    }
+
+    std::mutex mMutex;
+    std::condition_variable mWakeUp;
+    std::function<bool()> mTask;
+    bool mHasTask, mDone, mResult, mStop;
+    std::thread mThread;
+};
+
+}
+
+/**
+ * @brief Multiplies matrices stored in files (see Matrix::writeFile) and writes result into another file
+ * @details Result is computed tile by tile. While one step multiplies a pair of tiles, a background
+ * thread reads tiles of the next step and writes the result tile finished by the previous one,
+ * so computing overlaps with I/O. Tiles are square and as big as the budget allows: six tile buffers
+ * (two for each operand and two for result) together with packing buffers of GEMM (taken from
+ * the scratch arena of every thread) take at most memoryBudget bytes.
+ *
+ * @tparam T Type of elements
+ * @param lhsPath File of left matrix
+ * @param rhsPath File of right matrix
+ * @param resultPath File of result (replaced if exists)
+ * @param memoryBudget Memory for tiles and packing buffers in bytes
+ * @return bool Whether result was written (false if operands can't be read, their sizes don't fit
+ * or the budget can't hold even one element per tile)
+ */
+template<typename T>
+bool multiplyFiles(const std::string& lhsPath, const std::string& rhsPath, const std::string& resultPath, std::size_t memoryBudget) {
+    using Stream = detail::MatrixFileStream<T>;
+
+    std::unique_ptr<Stream> lhs = Stream::open(lhsPath), rhs = Stream::open(rhsPath);
+    if (!lhs || !rhs || lhs->getColumns() != rhs->getRows())
+        return false;
+
+    std::size_t m = lhs->getRows(), k = lhs->getColumns(), n = rhs->getColumns();
+
+    std::size_t tile = static_cast<std::size_t>(std::sqrt(static_cast<double>(memoryBudget / sizeof(T) / detail::OutOfCoreTileBuffers)));
+    if (tile >= detail::OutOfCoreTileAlignment)
+        tile = tile / detail::OutOfCoreTileAlignment * detail::OutOfCoreTileAlignment;
+    while (tile > 0 && detail::getOutOfCoreFootprint<T>(tile) > memoryBudget)
+        tile -= tile > detail::OutOfCoreTileAlignment ? detail::OutOfCoreTileAlignment : 1;
+    if (tile == 0)
+        return false;
+
+    // New file is filled by zeros, which is already the product when k is zero
+    std::unique_ptr<Stream> result = Stream::create(resultPath, m, n);
+    if (!result)
+        return false;
+    if (m == 0 || n == 0 || k == 0)
+        return true;
+
+    std::size_t tm = std::min(tile, m), tk = std::min(tile, k), tn = std::min(tile, n);
+    std::size_t rowTiles = (m + tm - 1) / tm, depthTiles = (k + tk - 1) / tk, columnTiles = (n + tn - 1) / tn;
+    std::size_t steps = rowTiles * columnTiles * depthTiles;
+
+    Matrix<T> a[2] = {Matrix<T>(tm, tk), Matrix<T>(tm, tk)};
+    Matrix<T> b[2] = {Matrix<T>(tk, tn), Matrix<T>(tk, tn)};
+    Matrix<T> c[2] = {Matrix<T>(tm, tn), Matrix<T>(tm, tn)};
+
+    // Step s multiplies tiles (i, p) and (p, j) with p changing fastest, so each result tile is finished in a row
+    struct Step {
+        std::size_t row, depth, column, rows, depths, columns;
+    };
+    auto getStep = [&](std::size_t step) {
+        std::size_t p = step % depthTiles, j = step / depthTiles % columnTiles, i = step / depthTiles / columnTiles;
+        return Step{i * tm, p * tk, j * tn, std::min(tm, m - i * tm), std::min(tk, k - p * tk), std::min(tn, n - j * tn)};
+    };
+
+    auto load = [&](std::size_t step, std::size_t buffer) {
+        Step s = getStep(step);
+        return lhs->readBlock(s.row, s.depth, s.rows, s.depths, a[buffer].getData(), a[buffer].getStride())
+            && rhs->readBlock(s.depth, s.column, s.depths, s.columns, b[buffer].getData(), b[buffer].getStride());
+    };
+
+    auto store = [&](std::size_t step, std::size_t buffer) {
+        Step s = getStep(step);
+        return result->writeBlock(s.row, s.column, s.rows, s.columns, c[buffer].getData(), c[buffer].getStride());
+    };
+
+    detail::OutOfCoreWorker io;
+    bool success = load(0, 0);
+    std::size_t resultBuffer = 0;
+    bool hasFinished = false;
+    std::size_t finishedStep = 0, finishedBuffer = 0;
+
+    for (std::size_t step = 0; step < steps && success; ++step) {
+        std::size_t buffer = step % 2;
+        bool write = hasFinished;
+        hasFinished = false;
+
+        io.start([&, step, buffer, write, finishedStep, finishedBuffer] {
+            bool loaded = step + 1 >= steps || load(step + 1, 1 - buffer);
+            bool written = !write || store(finishedStep, finishedBuffer);
+            return loaded && written;
+        });
+
+        Step s = getStep(step);
+        detail::gemm<T>(s.rows, s.columns, s.depths, T(1),
+                        a[buffer].getData(), a[buffer].getStride(), 1,
+                        b[buffer].getData(), b[buffer].getStride(), 1,
+                        s.depth == 0 ? T() : T(1), c[resultBuffer].getData(), c[resultBuffer].getStride(), 1);
+
+        success = io.wait();
+
+        if (s.depth + s.depths == k) {
+            hasFinished = true;
+            finishedStep = step;
+            finishedBuffer = resultBuffer;
+            resultBuffer = 1 - resultBuffer;
+        }
+    }
+
+    if (success && hasFinished)
+        success = store(finishedStep, finishedBuffer);
+
+    return success;
+}
+
+}
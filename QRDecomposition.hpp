@@ -0,0 +1,756 @@
+/**
+ * @brief Householder QR decomposition and least squares
+ *
+ * @file QRDecomposition.hpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include "Allocator.hpp"
+#include "Gemm.hpp"
+#include "Instrumentation.hpp"
+#include "Matrix.hpp"
+#include "Simd.hpp"
+#include "ThreadPool.hpp"
+#include "Triangular.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace MatrixCpp {
+
+namespace detail {
+
+/**
+ * @brief Number of columns whose reflectors are accumulated before the trailing matrix is updated
+ *
+ */
+constexpr std::size_t QRBlock = 64;
+
+/**
+ * @brief Number of rows which one task processes in passes over columns of tall matrices
+ *
+ */
+constexpr std::size_t QRRows = std::size_t(1) << 14;
+
+/**
+ * @brief Tall matrices are factored in chunks of rows with about this many elements (fit in L2 cache)
+ *
+ */
+constexpr std::size_t QRChunkElements = std::size_t(1) << 16;
+
+/**
+ * @brief Matrices with at most this many columns and enough rows for four chunks are factored by TSQR
+ *
+ */
+constexpr std::size_t QRTallColumns = 256;
+
+/**
+ * @brief Panels of at most this many columns and QRRows rows are factored column by column
+ * @details GEMMs that narrow mostly compute padding of micro-kernel tiles, while the unblocked
+ * loops walk the panel row by row once per column
+ *
+ */
+constexpr std::size_t QRPanelColumns = 16;
+
+/**
+ * @brief W = A^T * B + beta * W for tall rows x m A and rows x n B, W is m x n with stride n
+ * @details gemm splits its result into tiles, which leaves such small results to one thread,
+ * so here the rows are split between tasks and their partial products are added up.
+ *
+ */
+template<typename T>
+void qrMultiplyTransposed(std::size_t rows, std::size_t m, std::size_t n, const T* a, std::size_t strideA,
+                          const T* b, std::size_t strideB, T beta, T* w) {
+    const std::ptrdiff_t rsA = static_cast<std::ptrdiff_t>(strideA), rsB = static_cast<std::ptrdiff_t>(strideB),
+                         rsW = static_cast<std::ptrdiff_t>(n);
+    const std::size_t chunks = std::min(getThreadCount(), rows / QRRows);
+
+    if (chunks <= 1) {
+        gemm(m, n, rows, T(1), a, 1, rsA, b, rsB, 1, beta, w, rsW, 1);
+        return;
+    }
+
+    const std::size_t chunkRows = (rows + chunks - 1) / chunks;
+    ScratchBuffer<T> partial((chunks - 1) * m * n);
+
+    // Chunk 0 accumulates right into W, the others into partial
+    parallelFor(chunks, [&](std::size_t chunk) {
+        std::size_t begin = chunk * chunkRows, count = std::min(chunkRows, rows - begin);
+        gemm(m, n, count, T(1), a + begin * strideA, 1, rsA, b + begin * strideB, rsB, 1,
+             chunk == 0 ? beta : T(), chunk == 0 ? w : partial.data() + (chunk - 1) * m * n, rsW, 1);
+    });
+
+    const ElementwiseKernels<T>& kernels = getElementwiseKernels<T>();
+    for (std::size_t chunk = 1; chunk < chunks; ++chunk)
+        kernels.add(w, partial.data() + (chunk - 1) * m * n, m * n);
+}
+
+/**
+ * @brief Householder reflector H = I - tau * v * v^T which maps column x to (beta, 0, ..., 0)
+ * @details x[0] is replaced by beta and the rest of x by v (v[0] = 1 isn't stored)
+ *
+ * @param rows Number of elements in x
+ * @param stride Distance between elements of x
+ * @return T tau (0 if x has only zeros below the first element, then H = I)
+ */
+template<typename T>
+T qrHouseholder(std::size_t rows, T* x, std::size_t stride) {
+    const std::size_t chunks = (rows + QRRows - 1) / QRRows;
+    ScratchBuffer<T> partial(chunks);
+
+    parallelFor(chunks, [&](std::size_t chunk) {
+        std::size_t end = std::min(rows, (chunk + 1) * QRRows);
+        T sum = T();
+        for (std::size_t i = std::max<std::size_t>(1, chunk * QRRows); i < end; ++i)
+            sum += x[i * stride] * x[i * stride];
+        partial.data()[chunk] = sum;
+    });
+
+    T squares = T();
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+        squares += partial.data()[chunk];
+
+    if (squares == T())
+        return T();
+
+    const T alpha = x[0];
+    const T beta = -std::copysign(std::sqrt(alpha * alpha + squares), alpha);
+    const T scale = T(1) / (alpha - beta);
+
+    parallelFor(chunks, [&](std::size_t chunk) {
+        std::size_t end = std::min(rows, (chunk + 1) * QRRows);
+        for (std::size_t i = std::max<std::size_t>(1, chunk * QRRows); i < end; ++i)
+            x[i * stride] *= scale;
+    });
+
+    x[0] = beta;
+    return (beta - alpha) / beta;
+}
+
+/**
+ * @brief Copies unit lower triangle of the first size rows of V into contiguous size x size block
+ *
+ */
+template<typename T>
+void qrCopyUnitLower(std::size_t size, const T* v, std::size_t strideV, T* target) {
+    for (std::size_t i = 0; i < size; ++i)
+        for (std::size_t j = 0; j < size; ++j)
+            target[i * size + j] = j < i ? v[i * strideV + j] : (j == i ? T(1) : T());
+}
+
+/**
+ * @brief C = Q^T * C (transpose) or C = Q * C for block reflector Q = I - V * T * V^T
+ * @details V is rows x width unit lower trapezoidal (only below its diagonal is read, as stored in factors),
+ * T is width x width upper triangular with zeros below the diagonal and C is rows x columns. All work is GEMM.
+ *
+ */
+template<typename T>
+void qrApplyReflector(bool transpose, std::size_t rows, std::size_t width, const T* v, std::size_t strideV,
+                      const T* t, std::size_t strideT, std::size_t columns, T* c, std::size_t strideC) {
+    if (width == 0 || columns == 0)
+        return;
+
+    const std::ptrdiff_t rsV = static_cast<std::ptrdiff_t>(strideV), rsT = static_cast<std::ptrdiff_t>(strideT),
+                         rsC = static_cast<std::ptrdiff_t>(strideC), rsW = static_cast<std::ptrdiff_t>(columns),
+                         rsTop = static_cast<std::ptrdiff_t>(width);
+
+    ScratchBuffer<T> top(width * width), w(width * columns), product(width * columns);
+    qrCopyUnitLower(width, v, strideV, top.data());
+
+    // W = V^T * C
+    gemm(width, columns, width, T(1), top.data(), 1, rsTop, c, rsC, 1, T(), w.data(), rsW, 1);
+    qrMultiplyTransposed(rows - width, width, columns, v + width * strideV, strideV, c + width * strideC, strideC, T(1), w.data());
+
+    // W = T^T * W for Q^T, T * W for Q
+    gemm(width, columns, width, T(1), t, transpose ? 1 : rsT, transpose ? rsT : 1, w.data(), rsW, 1,
+         T(), product.data(), rsW, 1);
+
+    // C -= V * W
+    gemm(width, columns, width, T(-1), top.data(), rsTop, 1, product.data(), rsW, 1, T(1), c, rsC, 1);
+    gemm(rows - width, columns, width, T(-1), v + width * strideV, rsV, 1, product.data(), rsW, 1,
+         T(1), c + width * strideC, rsC, 1);
+}
+
+/**
+ * @brief Factors narrow rows x width panel (rows >= width) column by column with the same result as qrFactorizePanel
+ * @details Reflector of column j is applied to the columns right of it, then column j of T is
+ * T(0:j, j) = -tau(j) * T(0:j, 0:j) * V(:, 0:j)^T * v(j)
+ *
+ */
+template<typename T>
+void qrFactorizeColumns(std::size_t rows, std::size_t width, T* a, std::size_t stride, T* t, std::size_t strideT) {
+    ScratchBuffer<T> w(width);
+
+    for (std::size_t j = 0; j < width; ++j) {
+        T* column = a + j * stride + j;
+        const T tau = qrHouseholder(rows - j, column, stride);
+        T* z = w.data();
+
+        // z(k) = V(:, k)^T * v(j) for k < j, w(k) = v(j)^T * A(:, k) for k > j (v(j) is 1 at row j)
+        for (std::size_t k = 0; k < width; ++k)
+            z[k] = k == j ? T() : a[j * stride + k];
+        for (std::size_t i = j + 1; i < rows; ++i) {
+            const T* row = a + i * stride;
+            for (std::size_t k = 0; k < width; ++k)
+                z[k] += row[k] * row[j];
+        }
+
+        for (std::size_t i = j; i < rows; ++i) {
+            T* row = a + i * stride;
+            const T v = i == j ? T(1) : row[j];
+            for (std::size_t k = j + 1; k < width; ++k)
+                row[k] -= tau * v * z[k];
+        }
+
+        for (std::size_t k = 0; k < j; ++k) {
+            T sum = T();
+            for (std::size_t l = k; l < j; ++l)
+                sum += t[k * strideT + l] * z[l];
+            t[k * strideT + j] = -tau * sum;
+        }
+        t[j * strideT + j] = tau;
+    }
+}
+
+/**
+ * @brief Factors rows x width panel (rows >= width) by recursive Householder QR (Elmroth-Gustavson)
+ * @details R overwrites the upper triangle of the panel, Householder vectors the part below it, and
+ * T (upper triangle of width x width block, stride strideT) receives the factor of compact WY form
+ * H(0) * ... * H(width - 1) = I - V * T * V^T. The left half is factored first and applied to the right
+ * half as one block reflector, so even inside the panel almost all work is GEMM.
+ *
+ */
+template<typename T>
+void qrFactorizePanel(std::size_t rows, std::size_t width, T* a, std::size_t stride, T* t, std::size_t strideT) {
+    if (width <= QRPanelColumns && rows <= QRRows) {
+        qrFactorizeColumns(rows, width, a, stride, t, strideT);
+        return;
+    }
+
+    if (width == 1) {
+        t[0] = qrHouseholder(rows, a, stride);
+        return;
+    }
+
+    const std::size_t left = width / 2, right = width - left;
+    const std::ptrdiff_t rs = static_cast<std::ptrdiff_t>(stride), rsT = static_cast<std::ptrdiff_t>(strideT),
+                         rsRight = static_cast<std::ptrdiff_t>(right);
+
+    qrFactorizePanel(rows, left, a, stride, t, strideT);
+    qrApplyReflector(true, rows, left, a, stride, t, strideT, right, a + left, stride);
+    qrFactorizePanel(rows - left, right, a + left * stride + left, stride, t + left * strideT + left, strideT);
+
+    // T12 = -T11 * (V1^T * V2) * T22, where V2 starts at row `left` and V1 is full there
+    const T* v1 = a + left * stride;
+    const T* v2 = a + left * stride + left;
+    ScratchBuffer<T> top(right * right), s(left * right), product(left * right);
+    qrCopyUnitLower(right, v2, stride, top.data());
+
+    gemm(left, right, right, T(1), v1, 1, rs, top.data(), rsRight, 1, T(), s.data(), rsRight, 1);
+    qrMultiplyTransposed(rows - left - right, left, right, v1 + right * stride, stride, v2 + right * stride, stride,
+                         T(1), s.data());
+    gemm(left, right, left, T(1), t, rsT, 1, s.data(), rsRight, 1, T(), product.data(), rsRight, 1);
+    gemm(left, right, right, T(-1), product.data(), rsRight, 1, t + left * strideT + left, rsT, 1, T(), t + left, rsT, 1);
+}
+
+/**
+ * @brief Blocked Householder QR of rows x columns A (rows >= columns)
+ * @details Every block of QRBlock columns is factored by qrFactorizePanel and the trailing matrix
+ * is updated by its block reflector. Factor T of block b is kept in columns [b * QRBlock, b * QRBlock + width)
+ * of QRBlock x columns matrix t (which must be zero).
+ *
+ */
+template<typename T>
+void qrFactorize(std::size_t rows, std::size_t columns, T* a, std::size_t stride, T* t, std::size_t strideT) {
+    for (std::size_t block = 0; block < columns; block += QRBlock) {
+        std::size_t width = std::min(QRBlock, columns - block);
+        T* panel = a + block * stride + block;
+
+        qrFactorizePanel(rows - block, width, panel, stride, t + block, strideT);
+        qrApplyReflector(true, rows - block, width, panel, stride, t + block, strideT,
+                         columns - block - width, panel + width, stride);
+    }
+}
+
+/**
+ * @brief C = Q^T * C (transpose) or C = Q * C for Q of rows x columns factors made by qrFactorize
+ * @details Q = Q(0) * Q(1) * ..., so Q^T applies block reflectors in order and Q in reverse
+ *
+ * @param count Number of columns of C (which has rows rows)
+ */
+template<typename T>
+void qrApplyQ(bool transpose, std::size_t rows, std::size_t columns, const T* a, std::size_t stride,
+              const T* t, std::size_t strideT, std::size_t count, T* c, std::size_t strideC) {
+    const std::size_t blocks = (columns + QRBlock - 1) / QRBlock;
+
+    for (std::size_t index = 0; index < blocks; ++index) {
+        std::size_t block = (transpose ? index : blocks - 1 - index) * QRBlock;
+        std::size_t width = std::min(QRBlock, columns - block);
+
+        qrApplyReflector(transpose, rows - block, width, a + block * stride + block, stride, t + block, strideT,
+                         count, c + block * strideC, strideC);
+    }
+}
+
+}
+
+
+/**
+ * @brief Class to work with QR decomposition of matrix
+ * @details Computes A = Q * R for rows x columns A with rows >= columns by blocked Householder reflections.
+ * Q isn't formed: Householder vectors are kept below R and every block of them has its compact WY factor T,
+ * so applying Q or Q^T is a few GEMMs per block.
+ * Tall-skinny matrices are factored by TSQR: chunks of rows which fit in cache are factored in parallel,
+ * then their R factors, stacked on each other, are decomposed again (by TSQR too if they are still tall).
+ * So the long columns are read about once instead of once per column, and Q is the product of
+ * the chunks' reflectors and the reflectors of the stacked decomposition.
+ *
+ * @tparam T Type of matrix's elements (floating point)
+ */
+template<typename T>
+class QRDecomposition {
+    static_assert(std::is_floating_point<T>::value, "QR decomposition needs floating point type");
+
+public:
+    /**
+     * @brief Construct a new empty QRDecomposition object
+     *
+     */
+    QRDecomposition();
+
+    /**
+     * @brief Construct a new QRDecomposition object with decomposition of given matrix
+     *
+     * @param matrix Matrix to get decomposition
+     */
+    QRDecomposition(const Matrix<T>& matrix);
+
+    /**
+     * @brief Construct a new QRDecomposition object with decomposition of given block or expression
+     *
+     * @param matrix Matrix expression (e.g. SubMatrixView) to get decomposition
+     */
+    template<typename E>
+    QRDecomposition(const MatrixExpression<E, T>& matrix);
+
+    /**
+     * @brief Decomposes given matrix
+     *
+     * @param matrix Matrix to get decomposition
+     * @return true if decomposition was successfully gotten
+     * @return false if decomposition wasn't gotten (matrix has fewer rows than columns)
+     */
+    bool decompose(const Matrix<T>& matrix);
+
+    /**
+     * @brief Decomposes given block or expression
+     *
+     * @param matrix Matrix expression to get decomposition
+     * @return true if decomposition was successfully gotten
+     * @return false if decomposition wasn't gotten (matrix has fewer rows than columns)
+     */
+    template<typename E>
+    bool decompose(const MatrixExpression<E, T>& matrix);
+
+    /**
+     * @brief Get shared_ptr to thin Q (rows x columns, orthonormal columns, A = Q * R)
+     *
+     * @return std::shared_ptr<Matrix<T>> Q (nullptr if decomposition is empty)
+     */
+    std::shared_ptr<Matrix<T>> getQ() const;
+
+    /**
+     * @brief Get shared_ptr to R (columns x columns upper triangular, A = Q * R)
+     *
+     * @return std::shared_ptr<Matrix<T>> R (nullptr if decomposition is empty)
+     */
+    std::shared_ptr<Matrix<T>> getR() const;
+
+    /**
+     * @brief Multiplies by full (rows x rows) Q without forming it
+     *
+     * @param C Matrix with rows rows
+     * @return Matrix<T> Q * C (empty if decomposition is empty or sizes don't fit)
+     */
+    Matrix<T> applyQ(const Matrix<T>& C) const;
+
+    /**
+     * @brief Multiplies by transposed full (rows x rows) Q without forming it
+     *
+     * @param C Matrix with rows rows
+     * @return Matrix<T> Q^T * C (empty if decomposition is empty or sizes don't fit)
+     */
+    Matrix<T> applyQTransposed(const Matrix<T>& C) const;
+
+    /**
+     * @brief Get number of rows of decomposed matrix
+     *
+     * @return std::size_t Rows
+     */
+    std::size_t getRows() const;
+
+    /**
+     * @brief Get number of columns of decomposed matrix
+     *
+     * @return std::size_t Columns
+     */
+    std::size_t getColumns() const;
+
+    /**
+     * @brief Check is decomposition empty or not (empty when given matrix has fewer rows than columns)
+     *
+     * @return bool Is empty
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Check is decomposed matrix rank deficient (R has zero on the diagonal)
+     *
+     * @return bool Is rank deficient
+     */
+    bool isRankDeficient() const;
+
+    /**
+     * @brief Finds least squares solution: x minimizing ||A * x - b||
+     *
+     * @param b Right-hand side (rows elements)
+     * @return std::vector<T> Solution (empty if decomposition is empty, rank deficient or sizes don't fit)
+     */
+    std::vector<T> solve(const std::vector<T>& b) const;
+
+    /**
+     * @brief Finds least squares solutions for all columns of B at once
+     *
+     * @param B Right-hand sides (rows x k)
+     * @return Matrix<T> Solutions (columns x k, empty if decomposition is empty, rank deficient or sizes don't fit)
+     */
+    Matrix<T> solve(const Matrix<T>& B) const;
+
+private:
+    /**
+     * @brief Replaces C with Q^T * C or Q * C
+     *
+     */
+    void applyQInPlace(bool transpose, Matrix<T>& C) const;
+
+    /**
+     * @brief Get matrix whose upper triangle is R (own factors or factors of the stacked decomposition)
+     *
+     */
+    const Matrix<T>& getRFactors() const;
+
+    /**
+     * @brief Get number of chunks of rows (0 if the matrix isn't factored by TSQR)
+     *
+     */
+    std::size_t getChunks() const;
+
+    /**
+     * @brief Get number of rows in chunk (the last one takes the remainder)
+     *
+     */
+    std::size_t getChunkRows(std::size_t chunk) const;
+
+    /**
+     * @brief Packed R and Householder vectors (for TSQR: of every chunk)
+     *
+     */
+    Matrix<T> factors;
+
+    /**
+     * @brief Compact WY factors T of blocks of reflectors, side by side (for TSQR: one row of blocks per chunk)
+     *
+     */
+    Matrix<T> reflectors;
+
+    /**
+     * @brief Decomposition of stacked R factors of chunks (TSQR only)
+     *
+     */
+    std::shared_ptr<QRDecomposition<T>> stacked;
+
+    /**
+     * @brief Number of rows in chunks of TSQR (0 if it isn't used)
+     *
+     */
+    std::size_t chunkRows;
+
+    /**
+     * @brief Sets to true, if decomposition wasn't gotten
+     *
+     */
+    bool empty;
+};
+
+template<typename T>
+QRDecomposition<T>::QRDecomposition() {
+    chunkRows = 0;
+    empty = true;
+}
+
+template<typename T>
+QRDecomposition<T>::QRDecomposition(const Matrix<T>& matrix) {
+    decompose(matrix);
+}
+
+template<typename T>
+template<typename E>
+QRDecomposition<T>::QRDecomposition(const MatrixExpression<E, T>& matrix) {
+    decompose(matrix);
+}
+
+template<typename T>
+bool QRDecomposition<T>::decompose(const Matrix<T>& matrix) {
+    return decompose(static_cast<const MatrixExpression<Matrix<T>, T>&>(matrix));
+}
+
+template<typename T>
+template<typename E>
+bool QRDecomposition<T>::decompose(const MatrixExpression<E, T>& expression) {
+    const E& matrix = expression.derived();
+    const std::size_t rows = matrix.getRows(), columns = matrix.getColumns();
+
+    chunkRows = 0;
+    stacked.reset();
+
+    if (rows < columns || columns == 0) {
+        empty = true;
+        factors = Matrix<T>();
+        reflectors = Matrix<T>();
+        return !empty;
+    }
+
+    empty = false;
+
+    MATRIXCPP_INSTRUMENT(QRDecompose, 2.0 * rows * columns * columns - 2.0 / 3.0 * columns * columns * columns);
+
+    factors = matrix;
+
+    const std::size_t stride = factors.getStride(), blockRows = std::min(detail::QRBlock, columns);
+    const std::size_t tallRows = std::max(2 * columns, detail::QRChunkElements / columns);
+
+    if (columns > detail::QRTallColumns || rows < 4 * tallRows) {
+        reflectors = Matrix<T>(blockRows, columns);
+        detail::qrFactorize(rows, columns, factors.getData(), stride, reflectors.getData(), reflectors.getStride());
+        return !empty;
+    }
+
+    chunkRows = tallRows;
+    const std::size_t chunks = getChunks();
+    reflectors = Matrix<T>(chunks * blockRows, columns);
+
+    parallelFor(chunks, [&](std::size_t chunk) {
+        detail::qrFactorize(getChunkRows(chunk), columns, factors.getData() + chunk * chunkRows * stride, stride,
+                            reflectors.getData() + chunk * blockRows * reflectors.getStride(), reflectors.getStride());
+    });
+
+    // R factors of chunks on top of each other
+    Matrix<T> top(chunks * columns, columns);
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        for (std::size_t row = 0; row < columns; ++row) {
+            const T* source = factors.getData() + (chunk * chunkRows + row) * stride;
+            std::copy(source + row, source + columns, top.getData() + (chunk * columns + row) * top.getStride() + row);
+        }
+    }
+
+    stacked = std::make_shared<QRDecomposition<T>>(top);
+
+    return !empty;
+}
+
+template<typename T>
+std::shared_ptr<Matrix<T>> QRDecomposition<T>::getQ() const {
+    if (empty)
+        return nullptr;
+
+    const std::size_t rows = getRows(), columns = getColumns();
+    std::shared_ptr<Matrix<T>> q = std::make_shared<Matrix<T>>(rows, columns);
+    T* data = q->getData();
+    const std::size_t stride = q->getStride();
+
+    for (std::size_t i = 0; i < columns; ++i)
+        data[i * stride + i] = T(1);
+
+    if (chunkRows != 0) {
+        applyQInPlace(false, *q);
+        return q;
+    }
+
+    // Q * [I; 0] from the last block: columns left of a block are still columns of identity there
+    const std::size_t blocks = (columns + detail::QRBlock - 1) / detail::QRBlock;
+    for (std::size_t index = blocks; index-- > 0;) {
+        std::size_t block = index * detail::QRBlock;
+        std::size_t width = std::min(detail::QRBlock, columns - block);
+        detail::qrApplyReflector(false, rows - block, width, factors.getData() + block * factors.getStride() + block,
+                                 factors.getStride(), reflectors.getData() + block, reflectors.getStride(),
+                                 columns - block, data + block * stride + block, stride);
+    }
+
+    return q;
+}
+
+template<typename T>
+std::shared_ptr<Matrix<T>> QRDecomposition<T>::getR() const {
+    if (empty)
+        return nullptr;
+
+    const Matrix<T>& source = getRFactors();
+    const std::size_t columns = getColumns();
+    std::shared_ptr<Matrix<T>> r = std::make_shared<Matrix<T>>(columns, columns);
+
+    for (std::size_t row = 0; row < columns; ++row) {
+        const T* data = source.getData() + row * source.getStride();
+        std::copy(data + row, data + columns, r->getData() + row * r->getStride() + row);
+    }
+
+    return r;
+}
+
+template<typename T>
+Matrix<T> QRDecomposition<T>::applyQ(const Matrix<T>& C) const {
+    if (empty || C.getRows() != getRows())
+        return Matrix<T>();
+
+    Matrix<T> result = C;
+    applyQInPlace(false, result);
+
+    return result;
+}
+
+template<typename T>
+Matrix<T> QRDecomposition<T>::applyQTransposed(const Matrix<T>& C) const {
+    if (empty || C.getRows() != getRows())
+        return Matrix<T>();
+
+    Matrix<T> result = C;
+    applyQInPlace(true, result);
+
+    return result;
+}
+
+template<typename T>
+std::size_t QRDecomposition<T>::getRows() const {
+    return factors.getRows();
+}
+
+template<typename T>
+std::size_t QRDecomposition<T>::getColumns() const {
+    return factors.getColumns();
+}
+
+template<typename T>
+bool QRDecomposition<T>::isEmpty() const {
+    return empty;
+}
+
+template<typename T>
+bool QRDecomposition<T>::isRankDeficient() const {
+    if (empty)
+        return false;
+
+    const Matrix<T>& source = getRFactors();
+    for (std::size_t i = 0; i < getColumns(); ++i)
+        if (source.getData()[i * source.getStride() + i] == T())
+            return true;
+
+    return false;
+}
+
+template<typename T>
+std::vector<T> QRDecomposition<T>::solve(const std::vector<T>& b) const {
+    if (empty || b.size() != getRows())
+        return std::vector<T>();
+
+    Matrix<T> B(b.size(), 1);
+    std::copy(b.begin(), b.end(), B.getData());
+
+    Matrix<T> X = solve(B);
+    return std::vector<T>(X.getData(), X.getData() + X.getRows());
+}
+
+template<typename T>
+Matrix<T> QRDecomposition<T>::solve(const Matrix<T>& B) const {
+    if (empty || B.getRows() != getRows() || isRankDeficient())
+        return Matrix<T>();
+
+    const std::size_t columns = getColumns(), count = B.getColumns();
+    const Matrix<T>& r = getRFactors();
+
+    MATRIXCPP_INSTRUMENT(QRSolve, (4.0 * getRows() * columns - columns * columns) * count);
+
+    // x = R^-1 * (first columns rows of Q^T * b)
+    Matrix<T> C = B;
+    applyQInPlace(true, C);
+    detail::solveUpperTriangular(false, columns, count, r.getData(), r.getStride(), C.getData(), C.getStride());
+
+    Matrix<T> X(columns, count);
+    for (std::size_t row = 0; row < columns; ++row)
+        std::copy_n(C.getData() + row * C.getStride(), count, X.getData() + row * X.getStride());
+
+    return X;
+}
+
+template<typename T>
+void QRDecomposition<T>::applyQInPlace(bool transpose, Matrix<T>& C) const {
+    const std::size_t columns = getColumns(), count = C.getColumns();
+
+    if (chunkRows == 0) {
+        detail::qrApplyQ(transpose, getRows(), columns, factors.getData(), factors.getStride(),
+                         reflectors.getData(), reflectors.getStride(), count, C.getData(), C.getStride());
+        return;
+    }
+
+    const std::size_t chunks = getChunks(), blockRows = std::min(detail::QRBlock, columns);
+    auto applyChunks = [&] {
+        parallelFor(chunks, [&](std::size_t chunk) {
+            std::size_t begin = chunk * chunkRows;
+            detail::qrApplyQ(transpose, getChunkRows(chunk), columns, factors.getData() + begin * factors.getStride(),
+                             factors.getStride(), reflectors.getData() + chunk * blockRows * reflectors.getStride(),
+                             reflectors.getStride(), count, C.getData() + begin * C.getStride(), C.getStride());
+        });
+    };
+
+    // Q = diag(Q of chunks) * (Q of stacked decomposition acting on the first rows of every chunk)
+    if (transpose)
+        applyChunks();
+
+    Matrix<T> top(chunks * columns, count);
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+        for (std::size_t row = 0; row < columns; ++row)
+            std::copy_n(C.getData() + (chunk * chunkRows + row) * C.getStride(), count,
+                        top.getData() + (chunk * columns + row) * top.getStride());
+
+    stacked->applyQInPlace(transpose, top);
+
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+        for (std::size_t row = 0; row < columns; ++row)
+            std::copy_n(top.getData() + (chunk * columns + row) * top.getStride(), count,
+                        C.getData() + (chunk * chunkRows + row) * C.getStride());
+
+    if (!transpose)
+        applyChunks();
+}
+
+template<typename T>
+const Matrix<T>& QRDecomposition<T>::getRFactors() const {
+    return stacked ? stacked->getRFactors() : factors;
+}
+
+template<typename T>
+std::size_t QRDecomposition<T>::getChunks() const {
+    return chunkRows != 0 ? getRows() / chunkRows : 0;
+}
+
+template<typename T>
+std::size_t QRDecomposition<T>::getChunkRows(std::size_t chunk) const {
+    return chunk + 1 == getChunks() ? getRows() - chunk * chunkRows : chunkRows;
+}
+
+}
@@ -0,0 +1,455 @@
+/**
+ * @brief SIMD kernels for elementwise operations with runtime CPU dispatch
+ *
+ * @file Simd.hpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MATRIXCPP_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace MatrixCpp {
+
+/**
+ * @brief Instruction sets which elementwise kernels can use
+ *
+ */
+enum class SimdLevel {
+    Scalar,
+    SSE2,
+    AVX2,
+    AVX512
+};
+
+/**
+ * @brief Get the best instruction set supported by this CPU (detected once by CPUID)
+ *
+ * @return SimdLevel Instruction set used by elementwise kernels
+ */
+inline SimdLevel getSimdLevel() {
+    static const SimdLevel level = [] {
+#ifdef MATRIXCPP_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+            return SimdLevel::AVX512;
+        if (__builtin_cpu_supports("avx2"))
+            return SimdLevel::AVX2;
+        if (__builtin_cpu_supports("sse2"))
+            return SimdLevel::SSE2;
+#endif
+        return SimdLevel::Scalar;
+    }();
+
+    return level;
+}
+
+namespace detail {
+
+/**
+ * @brief Table of elementwise kernels for type T
+ * @details All kernels work on n contiguous elements, dst may alias src. dot and axpy are
+ * the building blocks of matrix-vector products.
+ *
+ * @tparam T Type of elements
+ */
+template<typename T>
+struct ElementwiseKernels {
+    void (*add)(T* dst, const T* src, std::size_t n);
+    void (*subtract)(T* dst, const T* src, std::size_t n);
+    void (*multiply)(T* dst, T value, std::size_t n);
+    void (*divide)(T* dst, T value, std::size_t n);
+    bool (*isZero)(const T* src, std::size_t n);
+    T (*dot)(const T* x, const T* y, std::size_t n);
+    void (*axpy)(T* dst, T value, const T* src, std::size_t n);
+};
+
+namespace scalar {
+
+template<typename T>
+void add(T* dst, const T* src, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i)
+        dst[i] += src[i];
+}
+
+template<typename T>
+void subtract(T* dst, const T* src, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i)
+        dst[i] -= src[i];
+}
+
+template<typename T>
+void multiply(T* dst, T value, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i)
+        dst[i] *= value;
+}
+
+template<typename T>
+void divide(T* dst, T value, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i)
+        dst[i] /= value;
+}
+
+template<typename T>
+bool isZero(const T* src, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        if (src[i] != T())
+            return false;
+    }
+    return true;
+}
+
+template<typename T>
+T dot(const T* x, const T* y, std::size_t n) {
+    T sum = T();
+    for (std::size_t i = 0; i < n; ++i)
+        sum += x[i] * y[i];
+    return sum;
+}
+
+template<typename T>
+void axpy(T* dst, T value, const T* src, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i)
+        dst[i] += value * src[i];
+}
+
+}
+
+#ifdef MATRIXCPP_SIMD_X86
+
+/*
+ * Every instruction set gets the same kernels, compiled with its own target attribute.
+ * V is a traits type which wraps intrinsics for one register type.
+ */
+#define MATRIXCPP_SIMD_KERNELS(TARGET)                                                      \
+    template<typename V>                                                                    \
+    TARGET void add(typename V::Scalar* dst, const typename V::Scalar* src, std::size_t n) { \
+        std::size_t i = 0;                                                                  \
+        for (; i + V::Width <= n; i += V::Width)                                            \
+            V::store(dst + i, V::add(V::load(dst + i), V::load(src + i)));                  \
+        scalar::add(dst + i, src + i, n - i);                                               \
+    }                                                                                       \
+                                                                                            \
+    template<typename V>                                                                    \
+    TARGET void subtract(typename V::Scalar* dst, const typename V::Scalar* src, std::size_t n) { \
+        std::size_t i = 0;                                                                  \
+        for (; i + V::Width <= n; i += V::Width)                                            \
+            V::store(dst + i, V::sub(V::load(dst + i), V::load(src + i)));                  \
+        scalar::subtract(dst + i, src + i, n - i);                                          \
+    }                                                                                       \
+                                                                                            \
+    template<typename V>                                                                    \
+    TARGET void multiply(typename V::Scalar* dst, typename V::Scalar value, std::size_t n) { \
+        typename V::Register factor = V::set1(value);                                       \
+        std::size_t i = 0;                                                                  \
+        for (; i + V::Width <= n; i += V::Width)                                            \
+            V::store(dst + i, V::mul(V::load(dst + i), factor));                            \
+        scalar::multiply(dst + i, value, n - i);                                            \
+    }                                                                                       \
+                                                                                            \
+    template<typename V>                                                                    \
+    TARGET void divide(typename V::Scalar* dst, typename V::Scalar value, std::size_t n) {  \
+        typename V::Register divisor = V::set1(value);                                      \
+        std::size_t i = 0;                                                                  \
+        for (; i + V::Width <= n; i += V::Width)                                            \
+            V::store(dst + i, V::div(V::load(dst + i), divisor));                           \
+        scalar::divide(dst + i, value, n - i);                                              \
+    }                                                                                       \
+                                                                                            \
+    template<typename V>                                                                    \
+    TARGET bool isZero(const typename V::Scalar* src, std::size_t n) {                      \
+        std::size_t i = 0;                                                                  \
+        for (; i + V::Width <= n; i += V::Width) {                                          \
+            if (!V::isZero(V::load(src + i)))                                               \
+                return false;                                                               \
+        }                                                                                   \
+        return scalar::isZero(src + i, n - i);                                              \
+    }                                                                                       \
+                                                                                            \
+    template<typename V>                                                                    \
+    TARGET typename V::Scalar dot(const typename V::Scalar* x, const typename V::Scalar* y, std::size_t n) { \
+        /* Four independent sums hide latency of additions */                               \
+        typename V::Register sums[4] = {V::set1(0), V::set1(0), V::set1(0), V::set1(0)};    \
+        std::size_t i = 0;                                                                  \
+        for (; i + 4 * V::Width <= n; i += 4 * V::Width) {                                  \
+            for (std::size_t j = 0; j < 4; ++j)                                             \
+                sums[j] = V::add(sums[j], V::mul(V::load(x + i + j * V::Width), V::load(y + i + j * V::Width))); \
+        }                                                                                   \
+        for (; i + V::Width <= n; i += V::Width)                                            \
+            sums[0] = V::add(sums[0], V::mul(V::load(x + i), V::load(y + i)));              \
+                                                                                            \
+        typename V::Scalar lanes[V::Width];                                                 \
+        V::store(lanes, V::add(V::add(sums[0], sums[1]), V::add(sums[2], sums[3])));        \
+        typename V::Scalar sum = scalar::dot(x + i, y + i, n - i);                          \
+        for (std::size_t lane = 0; lane < V::Width; ++lane)                                 \
+            sum += lanes[lane];                                                             \
+        return sum;                                                                         \
+    }                                                                                       \
+                                                                                            \
+    template<typename V>                                                                    \
+    TARGET void axpy(typename V::Scalar* dst, typename V::Scalar value, const typename V::Scalar* src, std::size_t n) { \
+        typename V::Register factor = V::set1(value);                                       \
+        std::size_t i = 0;                                                                  \
+        for (; i + V::Width <= n; i += V::Width)                                            \
+            V::store(dst + i, V::add(V::load(dst + i), V::mul(factor, V::load(src + i))));  \
+        scalar::axpy(dst + i, value, src + i, n - i);                                       \
+    }
+
+#define MATRIXCPP_TARGET_SSE2 __attribute__((target("sse2")))
+#define MATRIXCPP_TARGET_AVX2 __attribute__((target("avx2")))
+#define MATRIXCPP_TARGET_AVX512 __attribute__((target("avx512f")))
+
+template<typename T>
+struct IsSimdInteger : std::integral_constant<bool, std::is_integral<T>::value &&
+    !std::is_same<T, bool>::value && (sizeof(T) == 4 || sizeof(T) == 8)> {};
+
+namespace sse2 {
+
+template<typename T, typename Enable = void>
+struct Traits {
+    static constexpr bool Supported = false;
+};
+
+template<>
+struct Traits<float> {
+    static constexpr bool Supported = true, HasMultiply = true, HasDivide = true;
+    static constexpr std::size_t Width = 4;
+    using Scalar = float;
+    using Register = __m128;
+    MATRIXCPP_TARGET_SSE2 static Register load(const float* p) { return _mm_loadu_ps(p); }
+    MATRIXCPP_TARGET_SSE2 static void store(float* p, Register x) { _mm_storeu_ps(p, x); }
+    MATRIXCPP_TARGET_SSE2 static Register set1(float x) { return _mm_set1_ps(x); }
+    MATRIXCPP_TARGET_SSE2 static Register add(Register a, Register b) { return _mm_add_ps(a, b); }
+    MATRIXCPP_TARGET_SSE2 static Register sub(Register a, Register b) { return _mm_sub_ps(a, b); }
+    MATRIXCPP_TARGET_SSE2 static Register mul(Register a, Register b) { return _mm_mul_ps(a, b); }
+    MATRIXCPP_TARGET_SSE2 static Register div(Register a, Register b) { return _mm_div_ps(a, b); }
+    MATRIXCPP_TARGET_SSE2 static bool isZero(Register a) { return _mm_movemask_ps(_mm_cmpeq_ps(a, _mm_setzero_ps())) == 0xF; }
+};
+
+template<>
+struct Traits<double> {
+    static constexpr bool Supported = true, HasMultiply = true, HasDivide = true;
+    static constexpr std::size_t Width = 2;
+    using Scalar = double;
+    using Register = __m128d;
+    MATRIXCPP_TARGET_SSE2 static Register load(const double* p) { return _mm_loadu_pd(p); }
+    MATRIXCPP_TARGET_SSE2 static void store(double* p, Register x) { _mm_storeu_pd(p, x); }
+    MATRIXCPP_TARGET_SSE2 static Register set1(double x) { return _mm_set1_pd(x); }
+    MATRIXCPP_TARGET_SSE2 static Register add(Register a, Register b) { return _mm_add_pd(a, b); }
+    MATRIXCPP_TARGET_SSE2 static Register sub(Register a, Register b) { return _mm_sub_pd(a, b); }
+    MATRIXCPP_TARGET_SSE2 static Register mul(Register a, Register b) { return _mm_mul_pd(a, b); }
+    MATRIXCPP_TARGET_SSE2 static Register div(Register a, Register b) { return _mm_div_pd(a, b); }
+    MATRIXCPP_TARGET_SSE2 static bool isZero(Register a) { return _mm_movemask_pd(_mm_cmpeq_pd(a, _mm_setzero_pd())) == 0x3; }
+};
+
+template<typename T>
+struct Traits<T, typename std::enable_if<IsSimdInteger<T>::value>::type> {
+    static constexpr bool Supported = true, HasMultiply = false, HasDivide = false;
+    static constexpr std::size_t Width = 16 / sizeof(T);
+    using Scalar = T;
+    using Register = __m128i;
+    MATRIXCPP_TARGET_SSE2 static Register load(const T* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    MATRIXCPP_TARGET_SSE2 static void store(T* p, Register x) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), x); }
+    MATRIXCPP_TARGET_SSE2 static Register add(Register a, Register b) { return sizeof(T) == 4 ? _mm_add_epi32(a, b) : _mm_add_epi64(a, b); }
+    MATRIXCPP_TARGET_SSE2 static Register sub(Register a, Register b) { return sizeof(T) == 4 ? _mm_sub_epi32(a, b) : _mm_sub_epi64(a, b); }
+    MATRIXCPP_TARGET_SSE2 static bool isZero(Register a) { return _mm_movemask_epi8(_mm_cmpeq_epi32(a, _mm_setzero_si128())) == 0xFFFF; }
+};
+
+MATRIXCPP_SIMD_KERNELS(MATRIXCPP_TARGET_SSE2)
+
+}
+
+namespace avx2 {
+
+template<typename T, typename Enable = void>
+struct Traits {
+    static constexpr bool Supported = false;
+};
+
+template<>
+struct Traits<float> {
+    static constexpr bool Supported = true, HasMultiply = true, HasDivide = true;
+    static constexpr std::size_t Width = 8;
+    using Scalar = float;
+    using Register = __m256;
+    MATRIXCPP_TARGET_AVX2 static Register load(const float* p) { return _mm256_loadu_ps(p); }
+    MATRIXCPP_TARGET_AVX2 static void store(float* p, Register x) { _mm256_storeu_ps(p, x); }
+    MATRIXCPP_TARGET_AVX2 static Register set1(float x) { return _mm256_set1_ps(x); }
+    MATRIXCPP_TARGET_AVX2 static Register add(Register a, Register b) { return _mm256_add_ps(a, b); }
+    MATRIXCPP_TARGET_AVX2 static Register sub(Register a, Register b) { return _mm256_sub_ps(a, b); }
+    MATRIXCPP_TARGET_AVX2 static Register mul(Register a, Register b) { return _mm256_mul_ps(a, b); }
+    MATRIXCPP_TARGET_AVX2 static Register div(Register a, Register b) { return _mm256_div_ps(a, b); }
+    MATRIXCPP_TARGET_AVX2 static bool isZero(Register a) { return _mm256_movemask_ps(_mm256_cmp_ps(a, _mm256_setzero_ps(), _CMP_EQ_OQ)) == 0xFF; }
+};
+
+template<>
+struct Traits<double> {
+    static constexpr bool Supported = true, HasMultiply = true, HasDivide = true;
+    static constexpr std::size_t Width = 4;
+    using Scalar = double;
+    using Register = __m256d;
+    MATRIXCPP_TARGET_AVX2 static Register load(const double* p) { return _mm256_loadu_pd(p); }
+    MATRIXCPP_TARGET_AVX2 static void store(double* p, Register x) { _mm256_storeu_pd(p, x); }
+    MATRIXCPP_TARGET_AVX2 static Register set1(double x) { return _mm256_set1_pd(x); }
+    MATRIXCPP_TARGET_AVX2 static Register add(Register a, Register b) { return _mm256_add_pd(a, b); }
+    MATRIXCPP_TARGET_AVX2 static Register sub(Register a, Register b) { return _mm256_sub_pd(a, b); }
+    MATRIXCPP_TARGET_AVX2 static Register mul(Register a, Register b) { return _mm256_mul_pd(a, b); }
+    MATRIXCPP_TARGET_AVX2 static Register div(Register a, Register b) { return _mm256_div_pd(a, b); }
+    MATRIXCPP_TARGET_AVX2 static bool isZero(Register a) { return _mm256_movemask_pd(_mm256_cmp_pd(a, _mm256_setzero_pd(), _CMP_EQ_OQ)) == 0xF; }
+};
+
+template<typename T>
+struct Traits<T, typename std::enable_if<IsSimdInteger<T>::value>::type> {
+    static constexpr bool Supported = true, HasMultiply = sizeof(T) == 4, HasDivide = false;
+    static constexpr std::size_t Width = 32 / sizeof(T);
+    using Scalar = T;
+    using Register = __m256i;
+    MATRIXCPP_TARGET_AVX2 static Register load(const T* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    MATRIXCPP_TARGET_AVX2 static void store(T* p, Register x) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), x); }
+    MATRIXCPP_TARGET_AVX2 static Register set1(T x) {
+        return sizeof(T) == 4 ? _mm256_set1_epi32(static_cast<int>(x)) : _mm256_set1_epi64x(static_cast<long long>(x));
+    }
+    MATRIXCPP_TARGET_AVX2 static Register add(Register a, Register b) { return sizeof(T) == 4 ? _mm256_add_epi32(a, b) : _mm256_add_epi64(a, b); }
+    MATRIXCPP_TARGET_AVX2 static Register sub(Register a, Register b) { return sizeof(T) == 4 ? _mm256_sub_epi32(a, b) : _mm256_sub_epi64(a, b); }
+    MATRIXCPP_TARGET_AVX2 static Register mul(Register a, Register b) { return _mm256_mullo_epi32(a, b); }
+    MATRIXCPP_TARGET_AVX2 static bool isZero(Register a) { return _mm256_testz_si256(a, a) != 0; }
+};
+
+MATRIXCPP_SIMD_KERNELS(MATRIXCPP_TARGET_AVX2)
+
+}
+
+namespace avx512 {
+
+template<typename T, typename Enable = void>
+struct Traits {
+    static constexpr bool Supported = false;
+};
+
+template<>
+struct Traits<float> {
+    static constexpr bool Supported = true, HasMultiply = true, HasDivide = true;
+    static constexpr std::size_t Width = 16;
+    using Scalar = float;
+    using Register = __m512;
+    MATRIXCPP_TARGET_AVX512 static Register load(const float* p) { return _mm512_loadu_ps(p); }
+    MATRIXCPP_TARGET_AVX512 static void store(float* p, Register x) { _mm512_storeu_ps(p, x); }
+    MATRIXCPP_TARGET_AVX512 static Register set1(float x) { return _mm512_set1_ps(x); }
+    MATRIXCPP_TARGET_AVX512 static Register add(Register a, Register b) { return _mm512_add_ps(a, b); }
+    MATRIXCPP_TARGET_AVX512 static Register sub(Register a, Register b) { return _mm512_sub_ps(a, b); }
+    MATRIXCPP_TARGET_AVX512 static Register mul(Register a, Register b) { return _mm512_mul_ps(a, b); }
+    MATRIXCPP_TARGET_AVX512 static Register div(Register a, Register b) { return _mm512_div_ps(a, b); }
+    MATRIXCPP_TARGET_AVX512 static bool isZero(Register a) { return _mm512_cmp_ps_mask(a, _mm512_setzero_ps(), _CMP_EQ_OQ) == 0xFFFF; }
+};
+
+template<>
+struct Traits<double> {
+    static constexpr bool Supported = true, HasMultiply = true, HasDivide = true;
+    static constexpr std::size_t Width = 8;
+    using Scalar = double;
+    using Register = __m512d;
+    MATRIXCPP_TARGET_AVX512 static Register load(const double* p) { return _mm512_loadu_pd(p); }
+    MATRIXCPP_TARGET_AVX512 static void store(double* p, Register x) { _mm512_storeu_pd(p, x); }
+    MATRIXCPP_TARGET_AVX512 static Register set1(double x) { return _mm512_set1_pd(x); }
+    MATRIXCPP_TARGET_AVX512 static Register add(Register a, Register b) { return _mm512_add_pd(a, b); }
+    MATRIXCPP_TARGET_AVX512 static Register sub(Register a, Register b) { return _mm512_sub_pd(a, b); }
+    MATRIXCPP_TARGET_AVX512 static Register mul(Register a, Register b) { return _mm512_mul_pd(a, b); }
+    MATRIXCPP_TARGET_AVX512 static Register div(Register a, Register b) { return _mm512_div_pd(a, b); }
+    MATRIXCPP_TARGET_AVX512 static bool isZero(Register a) { return _mm512_cmp_pd_mask(a, _mm512_setzero_pd(), _CMP_EQ_OQ) == 0xFF; }
+};
+
+template<typename T>
+struct Traits<T, typename std::enable_if<IsSimdInteger<T>::value>::type> {
+    static constexpr bool Supported = true, HasMultiply = sizeof(T) == 4, HasDivide = false;
+    static constexpr std::size_t Width = 64 / sizeof(T);
+    using Scalar = T;
+    using Register = __m512i;
+    MATRIXCPP_TARGET_AVX512 static Register load(const T* p) { return _mm512_loadu_si512(p); }
+    MATRIXCPP_TARGET_AVX512 static void store(T* p, Register x) { _mm512_storeu_si512(p, x); }
+    MATRIXCPP_TARGET_AVX512 static Register set1(T x) {
+        return sizeof(T) == 4 ? _mm512_set1_epi32(static_cast<int>(x)) : _mm512_set1_epi64(static_cast<long long>(x));
+    }
+    MATRIXCPP_TARGET_AVX512 static Register add(Register a, Register b) { return sizeof(T) == 4 ? _mm512_add_epi32(a, b) : _mm512_add_epi64(a, b); }
+    MATRIXCPP_TARGET_AVX512 static Register sub(Register a, Register b) { return sizeof(T) == 4 ? _mm512_sub_epi32(a, b) : _mm512_sub_epi64(a, b); }
+    MATRIXCPP_TARGET_AVX512 static Register mul(Register a, Register b) { return _mm512_mullo_epi32(a, b); }
+    MATRIXCPP_TARGET_AVX512 static bool isZero(Register a) { return _mm512_test_epi32_mask(a, a) == 0; }
+};
+
+MATRIXCPP_SIMD_KERNELS(MATRIXCPP_TARGET_AVX512)
+
+}
+
+/*
+ * Fills table with kernels of one instruction set (scalar ones stay where it has no instruction)
+ */
+#define MATRIXCPP_USE_SIMD_KERNELS(ISA, T)                                                   \
+    do {                                                                                     \
+        using V = ISA::Traits<T>;                                                            \
+        kernels.add = &ISA::add<V>;                                                          \
+        kernels.subtract = &ISA::subtract<V>;                                                \
+        kernels.isZero = &ISA::isZero<V>;                                                    \
+        if constexpr (V::HasMultiply) {                                                      \
+            kernels.multiply = &ISA::multiply<V>;                                            \
+            kernels.dot = &ISA::dot<V>;                                                      \
+            kernels.axpy = &ISA::axpy<V>;                                                    \
+        }                                                                                    \
+        if constexpr (V::HasDivide)                                                          \
+            kernels.divide = &ISA::divide<V>;                                                \
+    } while (0)
+
+#endif
+
+/**
+ * @brief Builds table of kernels for type T and given instruction set
+ *
+ */
+template<typename T>
+ElementwiseKernels<T> makeElementwiseKernels(SimdLevel level) {
+    ElementwiseKernels<T> kernels = {
+        &scalar::add<T>, &scalar::subtract<T>, &scalar::multiply<T>,
+        &scalar::divide<T>, &scalar::isZero<T>, &scalar::dot<T>, &scalar::axpy<T>
+    };
+
+#ifdef MATRIXCPP_SIMD_X86
+    // Other types (e.g. std::complex) keep the generic loops
+    if constexpr (std::is_arithmetic<T>::value && sse2::Traits<T>::Supported) {
+        switch (level) {
+        case SimdLevel::AVX512:
+            MATRIXCPP_USE_SIMD_KERNELS(avx512, T);
+            break;
+        case SimdLevel::AVX2:
+            MATRIXCPP_USE_SIMD_KERNELS(avx2, T);
+            break;
+        case SimdLevel::SSE2:
+            MATRIXCPP_USE_SIMD_KERNELS(sse2, T);
+            break;
+        default:
+            break;
+        }
+    }
+#else
+    (void)level;
+#endif
+
+    return kernels;
+}
+
+/**
+ * @brief Get kernels for type T, chosen once for the CPU we run on
+ *
+ */
+template<typename T>
+const ElementwiseKernels<T>& getElementwiseKernels() {
+    static const ElementwiseKernels<T> kernels = makeElementwiseKernels<T>(getSimdLevel());
+    return kernels;
+}
+
+}
+}
@@ -0,0 +1,522 @@
+/**
+ * @brief Sparse matrix in compressed row (CSR) or compressed column (CSC) format
+ *
+ * @file SparseMatrix.hpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include "Matrix.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace MatrixCpp {
+
+/**
+ * @brief Storage format of sparse matrix
+ *
+ */
+enum class SparseFormat {
+    CSR, ///< Compressed rows: nonzeros are grouped by rows
+    CSC  ///< Compressed columns: nonzeros are grouped by columns
+};
+
+namespace detail {
+
+/**
+ * @brief Sparse products with fewer nonzeros than this run on one thread
+ *
+ */
+constexpr std::size_t SparseParallelThreshold = 1 << 14;
+
+}
+
+/**
+ * @brief Sparse matrix which stores only nonzero elements
+ * @details Nonzeros are grouped by major index (row for CSR, column for CSC):
+ * elements of major index i are at positions [offsets[i], offsets[i + 1]) of indices
+ * (minor index, sorted) and values. Memory and time of all operations are
+ * proportional to number of nonzeros, not to rows * columns.
+ *
+ * @tparam T Type of elements
+ */
+template<typename T>
+class SparseMatrix {
+public:
+    /**
+     * @brief Element given as (row, column, value)
+     *
+     */
+    using Triplet = std::tuple<std::size_t, std::size_t, T>;
+
+    /**
+     * @brief Construct a new empty SparseMatrix object (0 x 0)
+     *
+     */
+    SparseMatrix();
+
+    /**
+     * @brief Construct a new SparseMatrix object filled by zeros
+     *
+     * @param rows Number of rows
+     * @param columns Number of columns
+     * @param format Storage format
+     */
+    SparseMatrix(std::size_t rows, std::size_t columns, SparseFormat format = SparseFormat::CSR);
+
+    /**
+     * @brief Construct a new SparseMatrix object from nonzeros of dense matrix
+     *
+     * @param matrix Dense matrix
+     * @param format Storage format
+     */
+    explicit SparseMatrix(const Matrix<T>& matrix, SparseFormat format = SparseFormat::CSR);
+
+    /**
+     * @brief Construct a new SparseMatrix object from nonzeros of RawMatrix
+     *
+     * @param rawMatrix RawMatrix (rows of different length are padded by zeros)
+     * @param format Storage format
+     */
+    explicit SparseMatrix(const RawMatrix<T>& rawMatrix, SparseFormat format = SparseFormat::CSR);
+
+    /**
+     * @brief Build sparse matrix from list of elements without dense storage
+     * @details Duplicates are summed, elements out of bounds and zeros are skipped
+     *
+     * @param rows Number of rows
+     * @param columns Number of columns
+     * @param triplets Elements
+     * @param format Storage format
+     * @return SparseMatrix<T> Sparse matrix
+     */
+    static SparseMatrix fromTriplets(std::size_t rows, std::size_t columns, std::vector<Triplet> triplets, SparseFormat format = SparseFormat::CSR);
+
+    std::size_t getRows() const { return mRows; }
+    std::size_t getColumns() const { return mColumns; }
+    SparseFormat getFormat() const { return mFormat; }
+
+    /**
+     * @brief Get number of stored nonzeros
+     *
+     * @return std::size_t Number of nonzeros
+     */
+    std::size_t getNonZeros() const { return mValues.size(); }
+
+    const std::vector<std::size_t>& getOffsets() const { return mOffsets; }
+    const std::vector<std::size_t>& getIndices() const { return mIndices; }
+    const std::vector<T>& getValues() const { return mValues; }
+
+    /**
+     * @brief Get element (binary search in its row or column)
+     *
+     * @param row Row
+     * @param column Column
+     * @return T Element (zero if it isn't stored)
+     */
+    T get(std::size_t row, std::size_t column) const;
+
+    /**
+     * @brief Convert to given storage format
+     *
+     * @param format Storage format
+     * @return SparseMatrix<T> Matrix in format
+     */
+    SparseMatrix toFormat(SparseFormat format) const;
+
+    SparseMatrix toCSR() const { return toFormat(SparseFormat::CSR); }
+    SparseMatrix toCSC() const { return toFormat(SparseFormat::CSC); }
+
+    /**
+     * @brief Convert to dense matrix
+     *
+     * @return Matrix<T> Dense matrix
+     */
+    Matrix<T> toMatrix() const;
+
+    /**
+     * @brief Get transposed matrix
+     * @details CSR of matrix is CSC of transposed matrix, so arrays are just copied
+     * and format is flipped
+     *
+     * @return SparseMatrix<T> Transposed matrix (in the other format)
+     */
+    SparseMatrix transposed() const;
+
+    SparseMatrix& operator*=(const T& value);
+
+    /**
+     * @brief Overloading for operator * (sparse matrix by vector, parallel over rows for CSR)
+     *
+     * @param lhs Sparse matrix
+     * @param rhs Vector (getColumns() elements)
+     * @return std::vector<T> Product (empty if sizes don't match)
+     */
+    friend std::vector<T> operator*(const SparseMatrix& lhs, const std::vector<T>& rhs) {
+        return lhs.multiply(rhs);
+    }
+
+    /**
+     * @brief Overloading for operator * (sparse matrix by dense matrix)
+     *
+     * @param lhs Sparse matrix
+     * @param rhs Dense matrix
+     * @return Matrix<T> Product (empty if sizes don't match)
+     */
+    friend Matrix<T> operator*(const SparseMatrix& lhs, const Matrix<T>& rhs) {
+        return lhs.multiply(rhs);
+    }
+
+    /**
+     * @brief Overloading for operator + (sum of sparse matrices, in format of lhs)
+     *
+     * @param lhs Left matrix
+     * @param rhs Right matrix
+     * @return SparseMatrix Sum (lhs if shapes don't match)
+     */
+    friend SparseMatrix operator+(const SparseMatrix& lhs, const SparseMatrix& rhs) {
+        return lhs.combine(rhs, T(1));
+    }
+
+    /**
+     * @brief Overloading for operator - (difference of sparse matrices, in format of lhs)
+     *
+     * @param lhs Left matrix
+     * @param rhs Right matrix
+     * @return SparseMatrix Difference (lhs if shapes don't match)
+     */
+    friend SparseMatrix operator-(const SparseMatrix& lhs, const SparseMatrix& rhs) {
+        return lhs.combine(rhs, T(-1));
+    }
+
+    friend SparseMatrix operator*(SparseMatrix lhs, const T& rhs) { return std::move(lhs *= rhs); }
+    friend SparseMatrix operator*(const T& lhs, SparseMatrix rhs) { return std::move(rhs *= lhs); }
+
+private:
+    std::size_t getMajor() const { return mFormat == SparseFormat::CSR ? mRows : mColumns; }
+    std::size_t getMinor() const { return mFormat == SparseFormat::CSR ? mColumns : mRows; }
+
+    std::vector<T> multiply(const std::vector<T>& vector) const;
+    Matrix<T> multiply(const Matrix<T>& matrix) const;
+    SparseMatrix combine(const SparseMatrix& rhs, T factor) const;
+
+    /**
+     * @brief Calls body(begin, end) for ranges of rows (CSR) with about equal number of nonzeros
+     *
+     */
+    template<typename F>
+    void forEachRowRange(std::size_t work, const F& body) const;
+
+    std::size_t mRows;
+    std::size_t mColumns;
+    SparseFormat mFormat;
+    std::vector<std::size_t> mOffsets;
+    std::vector<std::size_t> mIndices;
+    std::vector<T> mValues;
+};
+
+template<typename T>
+SparseMatrix<T>::SparseMatrix() : SparseMatrix(0, 0) {}
+
+template<typename T>
+SparseMatrix<T>::SparseMatrix(std::size_t rows, std::size_t columns, SparseFormat format)
+    : mRows(rows), mColumns(columns), mFormat(format), mOffsets(getMajor() + 1, 0) {}
+
+template<typename T>
+SparseMatrix<T>::SparseMatrix(const Matrix<T>& matrix, SparseFormat format) : SparseMatrix(matrix.getRows(), matrix.getColumns()) {
+    const T* data = matrix.getData();
+    std::size_t stride = matrix.getStride();
+
+    for (std::size_t row = 0; row < mRows; ++row) {
+        for (std::size_t column = 0; column < mColumns; ++column) {
+            const T& value = data[row * stride + column];
+            if (value != T()) {
+                mIndices.push_back(column);
+                mValues.push_back(value);
+            }
+        }
+        mOffsets[row + 1] = mValues.size();
+    }
+
+    if (format != SparseFormat::CSR)
+        *this = toFormat(format);
+}
+
+template<typename T>
+SparseMatrix<T>::SparseMatrix(const RawMatrix<T>& rawMatrix, SparseFormat format) : SparseMatrix(rawMatrix.size(), 0) {
+    for (const auto& row : rawMatrix)
+        mColumns = std::max(mColumns, row.size());
+
+    for (std::size_t row = 0; row < mRows; ++row) {
+        const std::vector<T>& elements = rawMatrix[row];
+        for (std::size_t column = 0; column < elements.size(); ++column) {
+            if (elements[column] != T()) {
+                mIndices.push_back(column);
+                mValues.push_back(elements[column]);
+            }
+        }
+        mOffsets[row + 1] = mValues.size();
+    }
+
+    if (format != SparseFormat::CSR)
+        *this = toFormat(format);
+}
+
+template<typename T>
+SparseMatrix<T> SparseMatrix<T>::fromTriplets(std::size_t rows, std::size_t columns, std::vector<Triplet> triplets, SparseFormat format) {
+    SparseMatrix result(rows, columns, format);
+    bool rowMajor = format == SparseFormat::CSR;
+
+    auto key = [rowMajor](const Triplet& triplet) {
+        return rowMajor ? std::make_pair(std::get<0>(triplet), std::get<1>(triplet))
+                        : std::make_pair(std::get<1>(triplet), std::get<0>(triplet));
+    };
+
+    triplets.erase(std::remove_if(triplets.begin(), triplets.end(), [&](const Triplet& triplet) {
+        return std::get<0>(triplet) >= rows || std::get<1>(triplet) >= columns;
+    }), triplets.end());
+
+    std::sort(triplets.begin(), triplets.end(), [&](const Triplet& lhs, const Triplet& rhs) { return key(lhs) < key(rhs); });
+
+    for (std::size_t i = 0; i < triplets.size();) {
+        auto current = key(triplets[i]);
+        T sum = T();
+        for (; i < triplets.size() && key(triplets[i]) == current; ++i)
+            sum += std::get<2>(triplets[i]);
+
+        if (sum != T()) {
+            ++result.mOffsets[current.first + 1];
+            result.mIndices.push_back(current.second);
+            result.mValues.push_back(sum);
+        }
+    }
+
+    for (std::size_t major = 0; major < result.getMajor(); ++major)
+        result.mOffsets[major + 1] += result.mOffsets[major];
+
+    return result;
+}
+
+template<typename T>
+T SparseMatrix<T>::get(std::size_t row, std::size_t column) const {
+    if (row >= mRows || column >= mColumns)
+        return T();
+
+    std::size_t major = mFormat == SparseFormat::CSR ? row : column;
+    std::size_t minor = mFormat == SparseFormat::CSR ? column : row;
+
+    auto begin = mIndices.begin() + mOffsets[major], end = mIndices.begin() + mOffsets[major + 1];
+    auto found = std::lower_bound(begin, end, minor);
+
+    return found != end && *found == minor ? mValues[found - mIndices.begin()] : T();
+}
+
+template<typename T>
+SparseMatrix<T> SparseMatrix<T>::toFormat(SparseFormat format) const {
+    if (format == mFormat)
+        return *this;
+
+    // Counting sort by minor index: the result stays sorted inside every major index
+    SparseMatrix result(mRows, mColumns, format);
+    std::size_t majors = getMajor(), minors = getMinor();
+
+    for (std::size_t index : mIndices)
+        ++result.mOffsets[index + 1];
+    for (std::size_t minor = 0; minor < minors; ++minor)
+        result.mOffsets[minor + 1] += result.mOffsets[minor];
+
+    result.mIndices.resize(mValues.size());
+    result.mValues.resize(mValues.size());
+
+    std::vector<std::size_t> position(result.mOffsets.begin(), result.mOffsets.end() - 1);
+    for (std::size_t major = 0; major < majors; ++major) {
+        for (std::size_t i = mOffsets[major]; i < mOffsets[major + 1]; ++i) {
+            std::size_t target = position[mIndices[i]]++;
+            result.mIndices[target] = major;
+            result.mValues[target] = mValues[i];
+        }
+    }
+
+    return result;
+}
+
+template<typename T>
+Matrix<T> SparseMatrix<T>::toMatrix() const {
+    Matrix<T> matrix(mRows, mColumns);
+    T* data = matrix.getData();
+    std::size_t stride = matrix.getStride();
+
+    for (std::size_t major = 0; major < getMajor(); ++major) {
+        for (std::size_t i = mOffsets[major]; i < mOffsets[major + 1]; ++i) {
+            if (mFormat == SparseFormat::CSR)
+                data[major * stride + mIndices[i]] = mValues[i];
+            else
+                data[mIndices[i] * stride + major] = mValues[i];
+        }
+    }
+
+    return matrix;
+}
+
+template<typename T>
+SparseMatrix<T> SparseMatrix<T>::transposed() const {
+    SparseMatrix result(*this);
+    std::swap(result.mRows, result.mColumns);
+    result.mFormat = mFormat == SparseFormat::CSR ? SparseFormat::CSC : SparseFormat::CSR;
+    return result;
+}
+
+template<typename T>
+SparseMatrix<T>& SparseMatrix<T>::operator*=(const T& value) {
+    if (value == T()) {
+        *this = SparseMatrix(mRows, mColumns, mFormat);
+        return *this;
+    }
+
+    for (T& element : mValues)
+        element *= value;
+
+    return *this;
+}
+
+template<typename T>
+template<typename F>
+void SparseMatrix<T>::forEachRowRange(std::size_t work, const F& body) const {
+    std::size_t nonZeros = mValues.size();
+    std::size_t chunks = work < detail::SparseParallelThreshold ? 1 : std::min(mRows, 4 * getThreadCount());
+
+    if (chunks <= 1) {
+        body(std::size_t(0), mRows);
+        return;
+    }
+
+    // Split rows so that every chunk gets about the same number of nonzeros
+    std::vector<std::size_t> bounds(chunks + 1, mRows);
+    bounds[0] = 0;
+    for (std::size_t chunk = 1; chunk < chunks; ++chunk)
+        bounds[chunk] = std::upper_bound(mOffsets.begin(), mOffsets.end(), nonZeros * chunk / chunks) - mOffsets.begin() - 1;
+
+    parallelFor(chunks, [&](std::size_t chunk) {
+        if (bounds[chunk] < bounds[chunk + 1])
+            body(bounds[chunk], bounds[chunk + 1]);
+    });
+}
+
+template<typename T>
+std::vector<T> SparseMatrix<T>::multiply(const std::vector<T>& vector) const {
+    if (vector.size() != mColumns)
+        return std::vector<T>();
+
+    std::vector<T> result(mRows, T());
+
+    if (mFormat == SparseFormat::CSC) {
+        // Columns scatter into the same rows, so this one stays serial
+        for (std::size_t column = 0; column < mColumns; ++column) {
+            const T x = vector[column];
+            for (std::size_t i = mOffsets[column]; i < mOffsets[column + 1]; ++i)
+                result[mIndices[i]] += mValues[i] * x;
+        }
+        return result;
+    }
+
+    forEachRowRange(mValues.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t row = begin; row < end; ++row) {
+            T sum = T();
+            for (std::size_t i = mOffsets[row]; i < mOffsets[row + 1]; ++i)
+                sum += mValues[i] * vector[mIndices[i]];
+            result[row] = sum;
+        }
+    });
+
+    return result;
+}
+
+template<typename T>
+Matrix<T> SparseMatrix<T>::multiply(const Matrix<T>& matrix) const {
+    if (matrix.getRows() != mColumns)
+        return Matrix<T>();
+
+    // Rows of the result are independent only in CSR, converting costs O(nonzeros)
+    if (mFormat == SparseFormat::CSC)
+        return toCSR().multiply(matrix);
+
+    std::size_t columns = matrix.getColumns();
+    Matrix<T> result(mRows, columns);
+
+    const T* source = matrix.getData();
+    std::size_t sourceStride = matrix.getStride();
+    T* target = result.getData();
+    std::size_t targetStride = result.getStride();
+
+    forEachRowRange(mValues.size() * columns, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t row = begin; row < end; ++row) {
+            T* destination = target + row * targetStride;
+            for (std::size_t i = mOffsets[row]; i < mOffsets[row + 1]; ++i) {
+                const T value = mValues[i];
+                const T* other = source + mIndices[i] * sourceStride;
+                for (std::size_t column = 0; column < columns; ++column)
+                    destination[column] += value * other[column];
+            }
+        }
+    });
+
+    return result;
+}
+
+template<typename T>
+SparseMatrix<T> SparseMatrix<T>::combine(const SparseMatrix& other, T factor) const {
+    if (other.mRows != mRows || other.mColumns != mColumns)
+        return *this;
+
+    SparseMatrix converted;
+    const SparseMatrix* operand = &other;
+    if (other.mFormat != mFormat) {
+        converted = other.toFormat(mFormat);
+        operand = &converted;
+    }
+    const SparseMatrix& rhs = *operand;
+
+    SparseMatrix result(mRows, mColumns, mFormat);
+    result.mIndices.reserve(mValues.size() + rhs.mValues.size());
+    result.mValues.reserve(mValues.size() + rhs.mValues.size());
+
+    auto append = [&](std::size_t index, const T& value) {
+        if (value != T()) {
+            result.mIndices.push_back(index);
+            result.mValues.push_back(value);
+        }
+    };
+
+    // Merge sorted minor indices of every major index
+    for (std::size_t major = 0; major < getMajor(); ++major) {
+        std::size_t i = mOffsets[major], iEnd = mOffsets[major + 1];
+        std::size_t j = rhs.mOffsets[major], jEnd = rhs.mOffsets[major + 1];
+
+        while (i < iEnd || j < jEnd) {
+            if (j == jEnd || (i < iEnd && mIndices[i] < rhs.mIndices[j])) {
+                append(mIndices[i], mValues[i]);
+                ++i;
+            } else if (i == iEnd || rhs.mIndices[j] < mIndices[i]) {
+                append(rhs.mIndices[j], factor * rhs.mValues[j]);
+                ++j;
+            } else {
+                append(mIndices[i], mValues[i] + factor * rhs.mValues[j]);
+                ++i;
+                ++j;
+            }
+        }
+
+        result.mOffsets[major + 1] = result.mValues.size();
+    }
+
+    return result;
+}
+
+}
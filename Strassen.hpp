@@ -0,0 +1,186 @@
+/**
+ * @brief Strassen-Winograd multiplication for big products
+ *
+ * @file Strassen.hpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include "Allocator.hpp"
+#include "Gemm.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+namespace MatrixCpp {
+namespace detail {
+
+/**
+ * @brief Smallest size for which one level of recursion beats the blocked kernel
+ * @details Measured by bench/StrassenBenchmark.cpp: on AVX-512 x86 server one level wins from about
+ * 1900 for both float and double (by 5-10%, growing with size), below that the extra additions
+ * and worse cache reuse of halves cost more than the saved product
+ *
+ */
+constexpr std::size_t StrassenCrossover = 1900;
+
+/**
+ * @brief Number of rows which one task of additions processes
+ *
+ */
+constexpr std::size_t StrassenAddRows = 64;
+
+inline std::atomic<std::size_t>& getStrassenCrossoverSetting() {
+    static std::atomic<std::size_t> crossover(StrassenCrossover);
+    return crossover;
+}
+
+/**
+ * @brief z = x + sign * y for rows x columns blocks (z may be x or y)
+ *
+ */
+template<typename T>
+void strassenAdd(std::size_t rows, std::size_t columns, const T* x, std::size_t strideX, const T* y, std::size_t strideY,
+                 T sign, T* z, std::size_t strideZ) {
+    parallelFor((rows + StrassenAddRows - 1) / StrassenAddRows, [&](std::size_t chunk) {
+        std::size_t end = std::min(rows, (chunk + 1) * StrassenAddRows);
+        for (std::size_t row = chunk * StrassenAddRows; row < end; ++row) {
+            const T* left = x + row * strideX;
+            const T* right = y + row * strideY;
+            T* result = z + row * strideZ;
+            if (sign == T(1)) {
+                for (std::size_t column = 0; column < columns; ++column)
+                    result[column] = left[column] + right[column];
+            } else {
+                for (std::size_t column = 0; column < columns; ++column)
+                    result[column] = left[column] - right[column];
+            }
+        }
+    });
+}
+
+/**
+ * @brief C = alpha * A * B + beta * C by Strassen-Winograd recursion (7 products and 15 additions per level)
+ * @details A is m x k, B is k x n, all row-major. Recursion stops when a dimension is smaller than crossover,
+ * those products go to gemm. Odd dimensions are peeled off and fixed up by gemm. Each level takes two
+ * quadrant-sized temporaries from the scratch arena and uses quadrants of C for the rest of intermediate
+ * results, so the whole workspace is about (m * k + k * n) / 3 elements (plus m * n / 4 per level when beta != 0).
+ *
+ */
+template<typename T>
+void strassen(std::size_t m, std::size_t n, std::size_t k, T alpha,
+              const T* a, std::size_t strideA, const T* b, std::size_t strideB,
+              T beta, T* c, std::size_t strideC, std::size_t crossover) {
+    const std::ptrdiff_t rsA = static_cast<std::ptrdiff_t>(strideA), rsB = static_cast<std::ptrdiff_t>(strideB),
+                         rsC = static_cast<std::ptrdiff_t>(strideC);
+
+    if (m < 2 || n < 2 || k < 2 || std::min(m, std::min(n, k)) < crossover) {
+        gemm(m, n, k, alpha, a, rsA, 1, b, rsB, 1, beta, c, rsC, 1);
+        return;
+    }
+
+    if (beta != T()) {
+        // The schedule below overwrites C, so compute the product aside and combine
+        ScratchBuffer<T> product(m * n);
+        strassen(m, n, k, T(1), a, strideA, b, strideB, T(), product.data(), n, crossover);
+
+        for (std::size_t row = 0; row < m; ++row) {
+            T* target = c + row * strideC;
+            const T* source = product.data() + row * n;
+            for (std::size_t column = 0; column < n; ++column)
+                target[column] = alpha * source[column] + beta * target[column];
+        }
+        return;
+    }
+
+    std::size_t m2 = m / 2, n2 = n / 2, k2 = k / 2;
+
+    const T* a11 = a;
+    const T* a12 = a + k2;
+    const T* a21 = a + m2 * strideA;
+    const T* a22 = a21 + k2;
+    const T* b11 = b;
+    const T* b12 = b + n2;
+    const T* b21 = b + k2 * strideB;
+    const T* b22 = b21 + n2;
+    T* c11 = c;
+    T* c12 = c + n2;
+    T* c21 = c + m2 * strideC;
+    T* c22 = c21 + n2;
+
+    ScratchBuffer<T> x(m2 * k2), y(k2 * n2);
+
+    // C21 = P7 = (A11 - A21) * (B22 - B12)
+    strassenAdd(m2, k2, a11, strideA, a21, strideA, T(-1), x.data(), k2);
+    strassenAdd(k2, n2, b22, strideB, b12, strideB, T(-1), y.data(), n2);
+    strassen(m2, n2, k2, T(1), x.data(), k2, y.data(), n2, T(), c21, strideC, crossover);
+
+    // C22 = P5 = (A21 + A22) * (B12 - B11)
+    strassenAdd(m2, k2, a21, strideA, a22, strideA, T(1), x.data(), k2);
+    strassenAdd(k2, n2, b12, strideB, b11, strideB, T(-1), y.data(), n2);
+    strassen(m2, n2, k2, T(1), x.data(), k2, y.data(), n2, T(), c22, strideC, crossover);
+
+    // C12 = P6 = (A21 + A22 - A11) * (B22 - B12 + B11)
+    strassenAdd(m2, k2, x.data(), k2, a11, strideA, T(-1), x.data(), k2);
+    strassenAdd(k2, n2, b22, strideB, y.data(), n2, T(-1), y.data(), n2);
+    strassen(m2, n2, k2, T(1), x.data(), k2, y.data(), n2, T(), c12, strideC, crossover);
+
+    // C11 = P1 = A11 * B11
+    strassenAdd(m2, k2, a12, strideA, x.data(), k2, T(-1), x.data(), k2);
+    strassen(m2, n2, k2, T(1), a11, strideA, b11, strideB, T(), c11, strideC, crossover);
+
+    strassenAdd(m2, n2, c11, strideC, c12, strideC, T(1), c12, strideC);    // U2 = P1 + P6
+    strassenAdd(m2, n2, c12, strideC, c21, strideC, T(1), c21, strideC);    // U3 = U2 + P7
+    strassenAdd(m2, n2, c12, strideC, c22, strideC, T(1), c12, strideC);    // U4 = U2 + P5
+    strassenAdd(m2, n2, c21, strideC, c22, strideC, T(1), c22, strideC);    // C22 = U3 + P5
+
+    // C12 = U4 + (A12 - A21 - A22 + A11) * B22
+    strassen(m2, n2, k2, T(1), x.data(), k2, b22, strideB, T(1), c12, strideC, crossover);
+
+    // C21 = U3 - A22 * (B22 - B12 + B11 - B21)
+    strassenAdd(k2, n2, y.data(), n2, b21, strideB, T(-1), y.data(), n2);
+    strassen(m2, n2, k2, T(-1), a22, strideA, y.data(), n2, T(1), c21, strideC, crossover);
+
+    // C11 = P1 + A12 * B21
+    strassen(m2, n2, k2, T(1), a12, strideA, b21, strideB, T(1), c11, strideC, crossover);
+
+    if (alpha != T(1)) {
+        for (std::size_t row = 0; row < 2 * m2; ++row)
+            for (std::size_t column = 0; column < 2 * n2; ++column)
+                c[row * strideC + column] *= alpha;
+    }
+
+    // Odd dimensions: last column of A and row of B, last column and row of C
+    if (k % 2 != 0)
+        gemm(2 * m2, 2 * n2, std::size_t(1), alpha, a + 2 * k2, rsA, 1, b + 2 * k2 * strideB, rsB, 1, T(1), c, rsC, 1);
+    if (n % 2 != 0)
+        gemm(m, std::size_t(1), k, alpha, a, rsA, 1, b + 2 * n2, rsB, 1, beta, c + 2 * n2, rsC, 1);
+    if (m % 2 != 0)
+        gemm(std::size_t(1), 2 * n2, k, alpha, a + 2 * m2 * strideA, rsA, 1, b, rsB, 1, beta, c + 2 * m2 * strideC, rsC, 1);
+}
+
+}
+
+/**
+ * @brief Set size from which square products use Strassen-Winograd recursion
+ *
+ * @param size Size of matrices (0 turns Strassen-Winograd off)
+ */
+inline void setStrassenCrossover(std::size_t size) {
+    detail::getStrassenCrossoverSetting().store(size);
+}
+
+/**
+ * @brief Get size from which square products use Strassen-Winograd recursion
+ *
+ * @return std::size_t Size of matrices (0 if Strassen-Winograd is off)
+ */
+inline std::size_t getStrassenCrossover() {
+    return detail::getStrassenCrossoverSetting().load();
+}
+
+}
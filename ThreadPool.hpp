@@ -0,0 +1,482 @@
+/**
+ * @brief Executors and work-stealing thread pool used by parallel algorithms
+ *
+ * @file ThreadPool.hpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace MatrixCpp {
+
+/**
+ * @brief Interface of anything that can run tasks in background
+ * @details Implement it to run library's parallel work on your own threads
+ * and pass it to setExecutor()
+ *
+ */
+class Executor {
+public:
+    virtual ~Executor() {}
+
+    /**
+     * @brief Schedule task for execution
+     *
+     * @param task Task to run
+     */
+    virtual void execute(std::function<void()> task) = 0;
+
+    /**
+     * @brief Get number of tasks which can run at the same time
+     *
+     * @return std::size_t Number of background threads
+     */
+    virtual std::size_t getConcurrency() const = 0;
+};
+
+/**
+ * @brief Thread pool with per-thread task queues and work stealing
+ * @details A worker takes its newest task first and steals the oldest ones
+ * from other workers when its own queue is empty
+ *
+ */
+class ThreadPool : public Executor {
+public:
+    /**
+     * @brief Construct a new ThreadPool object
+     *
+     * @param threads Number of worker threads
+     */
+    explicit ThreadPool(std::size_t threads);
+
+    /**
+     * @brief Destroy the ThreadPool object (runs remaining tasks and joins threads)
+     *
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void execute(std::function<void()> task) override;
+
+    std::size_t getConcurrency() const override;
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    /**
+     * @brief Main loop of worker thread
+     *
+     * @param index Index of worker
+     */
+    void work(std::size_t index);
+
+    /**
+     * @brief Takes task from own queue or steals it from others
+     *
+     * @param index Index of worker which looks for task
+     * @param task Found task
+     * @return true if task was found
+     */
+    bool findTask(std::size_t index, std::function<void()>& task);
+
+    /**
+     * @brief Index of worker of this pool which runs on current thread (or -1)
+     *
+     */
+    std::size_t getCurrentWorker() const;
+
+    std::vector<std::unique_ptr<Queue>> mQueues;
+    std::vector<std::thread> mThreads;
+
+    std::mutex mSleepMutex;
+    std::condition_variable mWakeUp;
+    std::atomic<std::size_t> mPending;
+    std::atomic<std::size_t> mNextQueue;
+    bool mStop;
+
+    static thread_local const ThreadPool* sCurrentPool;
+    static thread_local std::size_t sCurrentWorker;
+};
+
+inline thread_local const ThreadPool* ThreadPool::sCurrentPool = nullptr;
+inline thread_local std::size_t ThreadPool::sCurrentWorker = static_cast<std::size_t>(-1);
+
+inline ThreadPool::ThreadPool(std::size_t threads) : mPending(0), mNextQueue(0), mStop(false) {
+    for (std::size_t i = 0; i < threads; ++i)
+        mQueues.push_back(std::unique_ptr<Queue>(new Queue()));
+
+    for (std::size_t i = 0; i < threads; ++i)
+        mThreads.emplace_back([this, i] { work(i); });
+}
+
+inline ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mStop = true;
+    }
+    mWakeUp.notify_all();
+
+    for (auto & thread : mThreads)
+        thread.join();
+}
+
+inline void ThreadPool::execute(std::function<void()> task) {
+    if (mQueues.empty()) {
+        task();
+        return;
+    }
+
+    std::size_t index = getCurrentWorker();
+    if (index >= mQueues.size())
+        index = mNextQueue.fetch_add(1, std::memory_order_relaxed) % mQueues.size();
+
+    // Count the task before it's visible, so a worker never takes it before it's counted
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mPending.fetch_add(1);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mQueues[index]->mutex);
+        mQueues[index]->tasks.push_back(std::move(task));
+    }
+    mWakeUp.notify_one();
+}
+
+inline std::size_t ThreadPool::getConcurrency() const {
+    return mThreads.size();
+}
+
+inline std::size_t ThreadPool::getCurrentWorker() const {
+    return sCurrentPool == this ? sCurrentWorker : static_cast<std::size_t>(-1);
+}
+
+inline bool ThreadPool::findTask(std::size_t index, std::function<void()>& task) {
+    {
+        Queue& own = *mQueues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    for (std::size_t i = 1; i < mQueues.size(); ++i) {
+        Queue& victim = *mQueues[(index + i) % mQueues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+inline void ThreadPool::work(std::size_t index) {
+    sCurrentPool = this;
+    sCurrentWorker = index;
+
+    std::function<void()> task;
+    while (true) {
+        if (findTask(index, task)) {
+            mPending.fetch_sub(1);
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mSleepMutex);
+        mWakeUp.wait(lock, [this] { return mStop || mPending.load() > 0; });
+        if (mStop && mPending.load() == 0)
+            return;
+    }
+}
+
+namespace detail {
+
+struct ExecutorRegistry {
+    std::mutex mutex;
+    std::shared_ptr<Executor> executor;
+    bool configured = false;
+};
+
+inline ExecutorRegistry& getExecutorRegistry() {
+    static ExecutorRegistry registry;
+    return registry;
+}
+
+inline std::shared_ptr<Executor> makeThreadPool(std::size_t threads) {
+    if (threads == 0)
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    // The calling thread always takes part in parallel loops
+    if (threads <= 1)
+        return nullptr;
+
+    return std::make_shared<ThreadPool>(threads - 1);
+}
+
+}
+
+/**
+ * @brief Run library's parallel work on given executor
+ *
+ * @param executor Executor (nullptr makes everything serial)
+ */
+inline void setExecutor(std::shared_ptr<Executor> executor) {
+    detail::ExecutorRegistry& registry = detail::getExecutorRegistry();
+    std::shared_ptr<Executor> previous;
+
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        previous = std::move(registry.executor);
+        registry.executor = std::move(executor);
+        registry.configured = true;
+    }
+
+    // previous pool joins its threads here, outside of the lock
+}
+
+/**
+ * @brief Run library's parallel work on own thread pool with given number of threads
+ *
+ * @param threads Number of threads including the calling one (0 means all hardware threads)
+ */
+inline void setThreadCount(std::size_t threads) {
+    setExecutor(detail::makeThreadPool(threads));
+}
+
+/**
+ * @brief Get executor for library's parallel work (pool of all hardware threads by default)
+ *
+ * @return std::shared_ptr<Executor> Executor or nullptr if work is serial
+ */
+inline std::shared_ptr<Executor> getExecutor() {
+    detail::ExecutorRegistry& registry = detail::getExecutorRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    if (!registry.configured) {
+        registry.executor = detail::makeThreadPool(0);
+        registry.configured = true;
+    }
+
+    return registry.executor;
+}
+
+/**
+ * @brief Get number of threads which parallel algorithms use
+ *
+ * @return std::size_t Number of threads including the calling one
+ */
+inline std::size_t getThreadCount() {
+    std::shared_ptr<Executor> executor = getExecutor();
+    return executor ? executor->getConcurrency() + 1 : 1;
+}
+
+/**
+ * @brief Calls body(i) for every i in [0, count) using all threads of executor
+ * @details The calling thread takes indices too, so nested parallel loops can't deadlock
+ *
+ * @param count Number of iterations
+ * @param body Body of loop
+ */
+template<typename F>
+void parallelFor(std::size_t count, const F& body) {
+    if (count == 0)
+        return;
+
+    std::shared_ptr<Executor> executor = count > 1 ? getExecutor() : nullptr;
+    std::size_t helpers = executor ? std::min(count - 1, executor->getConcurrency()) : 0;
+
+    if (helpers == 0) {
+        for (std::size_t i = 0; i < count; ++i)
+            body(i);
+        return;
+    }
+
+    struct State {
+        std::atomic<std::size_t> next{0};
+        std::atomic<std::size_t> done{0};
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+
+    std::shared_ptr<State> state = std::make_shared<State>();
+    const F* function = &body;
+
+    auto run = [state, function, count] {
+        std::size_t i;
+        while ((i = state->next.fetch_add(1)) < count) {
+            (*function)(i);
+            if (state->done.fetch_add(1) + 1 == count) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->finished.notify_all();
+            }
+        }
+    };
+
+    for (std::size_t i = 0; i < helpers; ++i)
+        executor->execute(run);
+
+    run();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&] { return state->done.load() == count; });
+}
+
+/**
+ * @brief Tasks with dependencies between them which run on all threads of executor
+ * @details A task starts when all tasks it depends on have finished. Of the ready tasks the one
+ * with the highest priority runs first (then the one added first), so the critical path can be
+ * kept ahead of the rest. Like in parallelFor(), the thread which calls run() takes tasks too.
+ *
+ */
+class TaskGraph {
+public:
+    TaskGraph();
+
+    /**
+     * @brief Add task to the graph
+     *
+     * @param task Task
+     * @param priority Ready tasks with higher priority run first
+     * @return std::size_t Index of task for precede()
+     */
+    std::size_t add(std::function<void()> task, std::size_t priority = 0);
+
+    /**
+     * @brief Make task `after` wait for task `before` (dependencies must not form a cycle)
+     *
+     */
+    void precede(std::size_t before, std::size_t after);
+
+    /**
+     * @brief Run all tasks and wait for them, then the graph is empty again
+     *
+     */
+    void run();
+
+private:
+    struct Ready {
+        std::size_t priority;
+        std::size_t index;
+
+        bool operator<(const Ready& other) const {
+            return priority != other.priority ? priority < other.priority : index > other.index;
+        }
+    };
+
+    struct State {
+        std::vector<std::function<void()>> tasks;
+        std::vector<std::size_t> priorities;
+        std::vector<std::vector<std::size_t>> successors;
+        std::vector<std::size_t> waiting;
+        std::priority_queue<Ready> ready;
+        std::size_t done = 0;
+        std::mutex mutex;
+        std::condition_variable wakeUp;
+    };
+
+    /**
+     * @brief Takes ready tasks until all tasks have finished
+     *
+     */
+    static void work(const std::shared_ptr<State>& state);
+
+    std::shared_ptr<State> mState;
+};
+
+inline TaskGraph::TaskGraph() : mState(std::make_shared<State>()) {}
+
+inline std::size_t TaskGraph::add(std::function<void()> task, std::size_t priority) {
+    mState->tasks.push_back(std::move(task));
+    mState->priorities.push_back(priority);
+    mState->successors.emplace_back();
+    mState->waiting.push_back(0);
+    return mState->tasks.size() - 1;
+}
+
+inline void TaskGraph::precede(std::size_t before, std::size_t after) {
+    mState->successors[before].push_back(after);
+    ++mState->waiting[after];
+}
+
+inline void TaskGraph::run() {
+    // Helpers may start after everything is done, so they get their own reference to the state
+    std::shared_ptr<State> state = std::move(mState);
+    mState = std::make_shared<State>();
+
+    const std::size_t count = state->tasks.size();
+    if (count == 0)
+        return;
+
+    for (std::size_t i = 0; i < count; ++i)
+        if (state->waiting[i] == 0)
+            state->ready.push(Ready{state->priorities[i], i});
+
+    std::shared_ptr<Executor> executor = count > 1 ? getExecutor() : nullptr;
+    std::size_t helpers = executor ? std::min(count - 1, executor->getConcurrency()) : 0;
+
+    for (std::size_t i = 0; i < helpers; ++i)
+        executor->execute([state] { work(state); });
+
+    work(state);
+}
+
+inline void TaskGraph::work(const std::shared_ptr<State>& state) {
+    const std::size_t count = state->tasks.size();
+    std::unique_lock<std::mutex> lock(state->mutex);
+
+    while (true) {
+        state->wakeUp.wait(lock, [&] { return !state->ready.empty() || state->done == count; });
+        if (state->ready.empty())
+            return;
+
+        std::size_t index = state->ready.top().index;
+        state->ready.pop();
+
+        lock.unlock();
+        state->tasks[index]();
+        state->tasks[index] = nullptr;
+        lock.lock();
+
+        std::size_t released = 0;
+        for (std::size_t next : state->successors[index]) {
+            if (--state->waiting[next] == 0) {
+                state->ready.push(Ready{state->priorities[next], next});
+                ++released;
+            }
+        }
+
+        // This thread takes one of the released tasks itself
+        if (++state->done == count)
+            state->wakeUp.notify_all();
+        else
+            for (std::size_t i = 1; i < released; ++i)
+                state->wakeUp.notify_one();
+    }
+}
+
+}
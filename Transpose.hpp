@@ -0,0 +1,105 @@
+/**
+ * @brief Cache-oblivious and in-place matrix transposition kernels
+ *
+ * @file Transpose.hpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+namespace MatrixCpp {
+namespace detail {
+
+/**
+ * @brief Blocks with fewer elements than this are transposed by a plain loop
+ * @details 32 x 32 doubles of source and destination fit in L1 together
+ *
+ */
+constexpr std::size_t TransposeBlock = 32;
+
+/**
+ * @brief Writes transposed rows x columns block of source into destination (columns x rows)
+ * @details Recursively halves the longer side, so at some level both blocks fit in cache
+ * whatever its size is. Source and destination must not overlap.
+ *
+ */
+template<typename T>
+void transposeBlock(std::size_t rows, std::size_t columns, const T* source, std::size_t sourceStride, T* destination, std::size_t destinationStride) {
+    while (rows > TransposeBlock || columns > TransposeBlock) {
+        if (rows >= columns) {
+            std::size_t half = rows / 2;
+            transposeBlock(half, columns, source, sourceStride, destination, destinationStride);
+            source += half * sourceStride;
+            destination += half;
+            rows -= half;
+        } else {
+            std::size_t half = columns / 2;
+            transposeBlock(rows, half, source, sourceStride, destination, destinationStride);
+            source += half;
+            destination += half * destinationStride;
+            columns -= half;
+        }
+    }
+
+    for (std::size_t row = 0; row < rows; ++row)
+        for (std::size_t column = 0; column < columns; ++column)
+            destination[column * destinationStride + row] = source[row * sourceStride + column];
+}
+
+/**
+ * @brief Swaps block A (rows x columns) with transposed block B (columns x rows)
+ * @details Used for off-diagonal blocks of square in-place transposition
+ *
+ */
+template<typename T>
+void transposeSwapBlock(std::size_t rows, std::size_t columns, T* a, T* b, std::size_t stride) {
+    while (rows > TransposeBlock || columns > TransposeBlock) {
+        if (rows >= columns) {
+            std::size_t half = rows / 2;
+            transposeSwapBlock(half, columns, a, b, stride);
+            a += half * stride;
+            b += half;
+            rows -= half;
+        } else {
+            std::size_t half = columns / 2;
+            transposeSwapBlock(rows, half, a, b, stride);
+            a += half;
+            b += half * stride;
+            columns -= half;
+        }
+    }
+
+    using std::swap;
+    for (std::size_t row = 0; row < rows; ++row)
+        for (std::size_t column = 0; column < columns; ++column)
+            swap(a[row * stride + column], b[column * stride + row]);
+}
+
+/**
+ * @brief Transposes square size x size block in place (no extra memory)
+ * @details Diagonal quadrants are transposed recursively, off-diagonal ones are swapped
+ * with each other transposed
+ *
+ */
+template<typename T>
+void transposeSquareInPlace(std::size_t size, T* data, std::size_t stride) {
+    if (size <= TransposeBlock) {
+        using std::swap;
+        for (std::size_t row = 1; row < size; ++row)
+            for (std::size_t column = 0; column < row; ++column)
+                swap(data[row * stride + column], data[column * stride + row]);
+        return;
+    }
+
+    std::size_t half = size / 2;
+    transposeSquareInPlace(half, data, stride);
+    transposeSquareInPlace(size - half, data + half * stride + half, stride);
+    transposeSwapBlock(half, size - half, data + half, data + half * stride, stride);
+}
+
+}
+}
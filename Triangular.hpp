@@ -0,0 +1,206 @@
+/**
+ * @brief Blocked triangular solves used by decompositions and products of triangular matrices
+ *
+ * @file Triangular.hpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ */
+
+#pragma once
+
+#include "Gemm.hpp"
+#include "Simd.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace MatrixCpp {
+namespace detail {
+
+/**
+ * @brief Triangular blocks up to this size are solved by substitution, bigger ones are split
+ * and most of the work goes to GEMM
+ *
+ */
+constexpr std::size_t TriangularBlock = 32;
+
+/**
+ * @brief Side of tiles into which products of triangular matrices are split
+ *
+ */
+constexpr std::size_t TriangularProductBlock = 256;
+
+/**
+ * @brief Solves L * X = B in place (X overwrites B)
+ * @details L is n x n lower triangular, B is n x m. Only the lower triangle of L is read.
+ *
+ * @param unitDiagonal Diagonal of L is ones and isn't read
+ * @param n Size of L
+ * @param m Number of columns in B
+ * @param l Pointer to L
+ * @param strideL Distance between rows of L
+ * @param b Pointer to B
+ * @param strideB Distance between rows of B
+ */
+template<typename T>
+void solveLowerTriangular(bool unitDiagonal, std::size_t n, std::size_t m, const T* l, std::size_t strideL, T* b, std::size_t strideB) {
+    if (n == 0 || m == 0)
+        return;
+
+    if (m == 1 && strideB == 1) {
+        // Contiguous vector: every row is a dot product with the solved part
+        const ElementwiseKernels<T>& kernels = getElementwiseKernels<T>();
+        for (std::size_t i = 0; i < n; ++i) {
+            const T* row = l + i * strideL;
+            T sum = b[i] - kernels.dot(row, b, i);
+            b[i] = unitDiagonal ? sum : sum / row[i];
+        }
+        return;
+    }
+
+    if (m == 1) {
+        for (std::size_t i = 0; i < n; ++i) {
+            const T* row = l + i * strideL;
+            T sum = b[i * strideB];
+            for (std::size_t k = 0; k < i; ++k)
+                sum -= row[k] * b[k * strideB];
+            b[i * strideB] = unitDiagonal ? sum : sum / row[i];
+        }
+        return;
+    }
+
+    if (n <= TriangularBlock) {
+        for (std::size_t i = 0; i < n; ++i) {
+            T* row = b + i * strideB;
+            for (std::size_t k = 0; k < i; ++k) {
+                const T factor = l[i * strideL + k];
+                const T* source = b + k * strideB;
+                for (std::size_t column = 0; column < m; ++column)
+                    row[column] -= factor * source[column];
+            }
+
+            if (!unitDiagonal) {
+                const T diagonal = l[i * strideL + i];
+                for (std::size_t column = 0; column < m; ++column)
+                    row[column] /= diagonal;
+            }
+        }
+        return;
+    }
+
+    std::size_t half = n / 2;
+    const std::ptrdiff_t rsL = static_cast<std::ptrdiff_t>(strideL), rsB = static_cast<std::ptrdiff_t>(strideB);
+
+    solveLowerTriangular(unitDiagonal, half, m, l, strideL, b, strideB);
+    gemm(n - half, m, half, T(-1),
+         l + half * strideL, rsL, 1,
+         b, rsB, 1,
+         T(1), b + half * strideB, rsB, 1);
+    solveLowerTriangular(unitDiagonal, n - half, m, l + half * strideL + half, strideL, b + half * strideB, strideB);
+}
+
+/**
+ * @brief Solves U * X = B in place (X overwrites B)
+ * @details U is n x n upper triangular, B is n x m. Only the upper triangle of U is read.
+ *
+ * @param unitDiagonal Diagonal of U is ones and isn't read
+ * @param n Size of U
+ * @param m Number of columns in B
+ * @param u Pointer to U
+ * @param strideU Distance between rows of U
+ * @param b Pointer to B
+ * @param strideB Distance between rows of B
+ */
+template<typename T>
+void solveUpperTriangular(bool unitDiagonal, std::size_t n, std::size_t m, const T* u, std::size_t strideU, T* b, std::size_t strideB) {
+    if (n == 0 || m == 0)
+        return;
+
+    if (m == 1 && strideB == 1) {
+        const ElementwiseKernels<T>& kernels = getElementwiseKernels<T>();
+        for (std::size_t i = n; i-- > 0;) {
+            const T* row = u + i * strideU;
+            T sum = b[i] - kernels.dot(row + i + 1, b + i + 1, n - i - 1);
+            b[i] = unitDiagonal ? sum : sum / row[i];
+        }
+        return;
+    }
+
+    if (m == 1) {
+        for (std::size_t i = n; i-- > 0;) {
+            const T* row = u + i * strideU;
+            T sum = b[i * strideB];
+            for (std::size_t k = i + 1; k < n; ++k)
+                sum -= row[k] * b[k * strideB];
+            b[i * strideB] = unitDiagonal ? sum : sum / row[i];
+        }
+        return;
+    }
+
+    if (n <= TriangularBlock) {
+        for (std::size_t i = n; i-- > 0;) {
+            T* row = b + i * strideB;
+            for (std::size_t k = i + 1; k < n; ++k) {
+                const T factor = u[i * strideU + k];
+                const T* source = b + k * strideB;
+                for (std::size_t column = 0; column < m; ++column)
+                    row[column] -= factor * source[column];
+            }
+
+            if (!unitDiagonal) {
+                const T diagonal = u[i * strideU + i];
+                for (std::size_t column = 0; column < m; ++column)
+                    row[column] /= diagonal;
+            }
+        }
+        return;
+    }
+
+    std::size_t half = n / 2;
+    const std::ptrdiff_t rsU = static_cast<std::ptrdiff_t>(strideU), rsB = static_cast<std::ptrdiff_t>(strideB);
+
+    solveUpperTriangular(unitDiagonal, n - half, m, u + half * strideU + half, strideU, b + half * strideB, strideB);
+    gemm(half, m, n - half, T(-1),
+         u + half, rsU, 1,
+         b + half * strideB, rsB, 1,
+         T(1), b, rsB, 1);
+    solveUpperTriangular(unitDiagonal, half, m, u, strideU, b, strideB);
+}
+
+/**
+ * @brief C = A * B for n x n triangular A and B (both upper or both lower)
+ * @details The product is triangular as well and its element (i, j) only sums over k between i and j,
+ * so every tile of C multiplies just the strip of A and B between its row and column: about n^3 / 3
+ * flops instead of 2 n^3. Tiles on the other side of the diagonal are set to zero.
+ *
+ * @param upper Matrices are upper triangular (lower otherwise)
+ */
+template<typename T>
+void multiplyTriangular(bool upper, std::size_t n, const T* a, std::size_t strideA, const T* b, std::size_t strideB,
+                        T* c, std::size_t strideC) {
+    const std::size_t blocks = (n + TriangularProductBlock - 1) / TriangularProductBlock;
+    const std::ptrdiff_t rsA = static_cast<std::ptrdiff_t>(strideA), rsB = static_cast<std::ptrdiff_t>(strideB),
+                         rsC = static_cast<std::ptrdiff_t>(strideC);
+
+    parallelFor(blocks * blocks, [&](std::size_t tile) {
+        std::size_t blockRow = tile / blocks, blockColumn = tile % blocks;
+        std::size_t row = blockRow * TriangularProductBlock, column = blockColumn * TriangularProductBlock;
+        std::size_t rows = std::min(TriangularProductBlock, n - row), columns = std::min(TriangularProductBlock, n - column);
+        T* target = c + row * strideC + column;
+
+        if (upper ? blockColumn < blockRow : blockColumn > blockRow) {
+            for (std::size_t i = 0; i < rows; ++i)
+                std::fill_n(target + i * strideC, columns, T());
+            return;
+        }
+
+        // Inside diagonal tiles the zero half of A and B gives exact zeros
+        std::size_t begin = upper ? row : column, end = upper ? column + columns : row + rows;
+        gemm(rows, columns, end - begin, T(1), a + row * strideA + begin, rsA, 1,
+             b + begin * strideB + column, rsB, 1, T(), target, rsC, 1);
+    });
+}
+
+}
+}
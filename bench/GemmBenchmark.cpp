@@ -0,0 +1,129 @@
+/**
+ * @brief Benchmark of matrix multiplication: blocked kernel against the plain triple loop
+ *
+ * @file GemmBenchmark.cpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ *
+ * Build: g++ -std=c++17 -O3 -march=native -I.. GemmBenchmark.cpp -o GemmBenchmark
+ * Add -DMATRIXCPP_BENCH_CBLAS -lopenblas to compare with a tuned BLAS too.
+ */
+
+#include "../Matrix.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+#ifdef MATRIXCPP_BENCH_CBLAS
+#include <cblas.h>
+#endif
+
+using namespace MatrixCpp;
+
+namespace {
+
+template<typename T>
+Matrix<T> randomMatrix(std::size_t rows, std::size_t columns) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+    Matrix<T> matrix(rows, columns);
+    for (std::size_t r = 0; r < rows; ++r)
+        for (std::size_t c = 0; c < columns; ++c)
+            matrix.set(r, c, static_cast<T>(distribution(generator)));
+
+    return matrix;
+}
+
+/**
+ * @brief Triple loop which Matrix::operator*= used before the blocked kernel
+ *
+ */
+template<typename T>
+Matrix<T> naiveMultiply(const Matrix<T>& lhs, const Matrix<T>& rhs) {
+    Matrix<T> result(lhs.getRows(), rhs.getColumns());
+
+    for (std::size_t row = 0; row < lhs.getRows(); ++row) {
+        for (std::size_t column = 0; column < rhs.getColumns(); ++column) {
+            T sum = 0;
+            for (std::size_t r = 0; r < lhs.getColumns(); ++r)
+                sum += lhs.get(row, r) * rhs.get(r, column);
+            result.set(row, column, sum);
+        }
+    }
+
+    return result;
+}
+
+template<typename F>
+double bestSeconds(F&& function, double budget = 0.5) {
+    double best = 1e30, total = 0;
+    int runs = 0;
+
+    while (runs < 3 || (total < budget && runs < 50)) {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = std::min(best, seconds);
+        total += seconds;
+        ++runs;
+    }
+
+    return best;
+}
+
+#ifdef MATRIXCPP_BENCH_CBLAS
+void blasMultiply(const Matrix<double>& a, const Matrix<double>& b, Matrix<double>& c) {
+    cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, a.getRows(), b.getColumns(), a.getColumns(),
+                1.0, a.getData(), a.getStride(), b.getData(), b.getStride(), 0.0, c.getData(), c.getStride());
+}
+
+void blasMultiply(const Matrix<float>& a, const Matrix<float>& b, Matrix<float>& c) {
+    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, a.getRows(), b.getColumns(), a.getColumns(),
+                1.0f, a.getData(), a.getStride(), b.getData(), b.getStride(), 0.0f, c.getData(), c.getStride());
+}
+#endif
+
+template<typename T>
+void run(const char* type, std::size_t m, std::size_t k, std::size_t n, bool withNaive) {
+    Matrix<T> a = randomMatrix<T>(m, k), b = randomMatrix<T>(k, n);
+    double flops = 2.0 * m * n * k;
+
+    double blocked = bestSeconds([&] { Matrix<T> c; c = a; c *= b; });
+    std::printf("%-6s %5zux%5zux%5zu  blocked %8.2f GFLOP/s", type, m, k, n, flops / blocked * 1e-9);
+
+    if (withNaive) {
+        double naive = bestSeconds([&] { naiveMultiply(a, b); }, 0.2);
+        std::printf("  loop %8.2f GFLOP/s  speedup %6.1fx", flops / naive * 1e-9, naive / blocked);
+    }
+
+#ifdef MATRIXCPP_BENCH_CBLAS
+    Matrix<T> c(m, n);
+    double blas = bestSeconds([&] { blasMultiply(a, b, c); });
+    std::printf("  blas %8.2f GFLOP/s  (%3.0f%% of blas)", flops / blas * 1e-9, 100.0 * blas / blocked);
+#endif
+
+    std::printf("\n");
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::size_t maxSize = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1024;
+
+    for (std::size_t size = 64; size <= maxSize; size *= 2) {
+        bool withNaive = size <= 1024;
+        run<double>("double", size, size, size, withNaive);
+        run<float>("float", size, size, size, withNaive);
+    }
+
+    // rectangular shapes
+    run<double>("double", 2000, 64, 2000, false);
+    run<double>("double", 64, 2000, 64, true);
+    run<float>("float", 1000, 3000, 500, false);
+
+    return 0;
+}
@@ -0,0 +1,571 @@
+/**
+ * @brief Benchmark suite of Matrix operations with JSON output and comparison of runs
+ *
+ * @file MatrixBenchmark.cpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ *
+ * Build: cmake -S .. -B build && cmake --build build --target matrixcpp_bench
+ * Usage: matrixcpp_bench [--sizes 16,64,256,1024] [--types float,double] [--filter text]
+ *                        [--min-time seconds] [--json file]
+ *        matrixcpp_bench --compare base.json new.json [--threshold percent]
+ */
+
+#include "../Matrix.hpp"
+#include "../LUDecomposition.hpp"
+#include "../CholeskyDecomposition.hpp"
+#include "../MixedPrecisionLU.hpp"
+#include "../QRDecomposition.hpp"
+#include "../Determinant.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace MatrixCpp;
+
+namespace {
+
+/**
+ * @brief Every benchmark is measured this many times, the median is reported
+ *
+ */
+constexpr int Samples = 5;
+
+struct Options {
+    std::vector<std::size_t> sizes = {16, 64, 256, 1024};
+    std::vector<std::string> types = {"float", "double"};
+    std::string filter;
+    double minTime = 0.5;
+    std::string json;
+};
+
+struct Result {
+    std::string operation;
+    std::string type;
+    std::size_t size;
+    std::uint64_t iterations;
+    double nsPerOp;
+    double nsPerOpMin;
+    double gflops;
+    double gbps;
+
+    std::string getName() const {
+        return operation + "/" + type + "/" + std::to_string(size);
+    }
+};
+
+template<typename T>
+void doNotOptimize(const T& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+template<typename T>
+Matrix<T> randomMatrix(std::size_t rows, std::size_t columns, unsigned seed) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+    Matrix<T> matrix(rows, columns);
+    for (std::size_t r = 0; r < rows; ++r)
+        for (std::size_t c = 0; c < columns; ++c)
+            matrix.set(r, c, static_cast<T>(distribution(generator)));
+
+    return matrix;
+}
+
+double elapsed(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Times operation: a warm-up call, then Samples runs of enough iterations to fill minTime
+ *
+ */
+template<typename F>
+Result measure(F&& operation, double minTime) {
+    operation();
+
+    auto start = std::chrono::steady_clock::now();
+    operation();
+    double single = std::max(elapsed(start), 1e-9);
+
+    std::uint64_t iterations = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(minTime / Samples / single));
+    std::vector<double> samples;
+
+    for (int sample = 0; sample < Samples; ++sample) {
+        start = std::chrono::steady_clock::now();
+        for (std::uint64_t i = 0; i < iterations; ++i)
+            operation();
+        samples.push_back(elapsed(start) * 1e9 / static_cast<double>(iterations));
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    Result result = {};
+    result.iterations = iterations * Samples;
+    result.nsPerOp = samples[Samples / 2];
+    result.nsPerOpMin = samples.front();
+    return result;
+}
+
+class Suite {
+public:
+    explicit Suite(const Options& options) : mOptions(options) {
+        std::printf("%-16s %-7s %6s %14s %10s %10s\n", "operation", "type", "size", "ns/op", "GFLOP/s", "GB/s");
+    }
+
+    /**
+     * @brief Runs benchmark if it passes the filter
+     *
+     * @param flops Floating point operations done by one call
+     * @param bytes Bytes one call has to read and write at least
+     */
+    template<typename F>
+    void run(const char* operation, const char* type, std::size_t size, double flops, double bytes, F&& function) {
+        Result probe = {};
+        probe.operation = operation;
+        probe.type = type;
+        probe.size = size;
+        if (probe.getName().find(mOptions.filter) == std::string::npos)
+            return;
+
+        Result result = measure(function, mOptions.minTime);
+        result.operation = operation;
+        result.type = type;
+        result.size = size;
+        result.gflops = flops / result.nsPerOp;
+        result.gbps = bytes / result.nsPerOp;
+
+        std::printf("%-16s %-7s %6zu %14.1f %10.2f %10.2f\n", operation, type, size, result.nsPerOp, result.gflops, result.gbps);
+        std::fflush(stdout);
+        mResults.push_back(result);
+    }
+
+    const std::vector<Result>& getResults() const {
+        return mResults;
+    }
+
+private:
+    const Options& mOptions;
+    std::vector<Result> mResults;
+};
+
+template<typename T>
+void runType(Suite& suite, const char* type, const std::vector<std::size_t>& sizes) {
+    for (std::size_t n : sizes) {
+        const double elements = static_cast<double>(n) * n, cube = elements * n, bytes = elements * sizeof(T);
+
+        const Matrix<T> a = randomMatrix<T>(n, n, 1), b = randomMatrix<T>(n, n, 2);
+        // Multiplying by the averaging matrix keeps values bounded however many times it's repeated
+        const Matrix<T> averaging(n, n, T(1) / static_cast<T>(n));
+        Matrix<T> c = a;
+
+        suite.run("construct", type, n, 0, bytes, [&] {
+            Matrix<T> matrix(n, n, T(1));
+            doNotOptimize(matrix.getData());
+        });
+
+        suite.run("get_set", type, n, elements, 2 * bytes, [&] {
+            for (std::size_t row = 0; row < n; ++row)
+                for (std::size_t column = 0; column < n; ++column)
+                    c.set(row, column, c.get(row, column) + T(1));
+            doNotOptimize(c.getData());
+        });
+
+        c = a;
+        suite.run("add_assign", type, n, elements, 3 * bytes, [&] {
+            c += b;
+            doNotOptimize(c.getData());
+        });
+
+        c = a;
+        suite.run("multiply_assign", type, n, 2 * cube, 3 * bytes, [&] {
+            c *= averaging;
+            doNotOptimize(c.getData());
+        });
+
+        const Matrix<T> column = randomMatrix<T>(n, 1, 3), row = randomMatrix<T>(1, n, 4);
+        suite.run("gemv", type, n, 2 * elements, bytes, [&] {
+            Matrix<T> product = a * column;
+            doNotOptimize(product.getData());
+        });
+
+        suite.run("gevm", type, n, 2 * elements, bytes, [&] {
+            Matrix<T> product = row * a;
+            doNotOptimize(product.getData());
+        });
+
+        suite.run("transpose", type, n, 0, 2 * bytes, [&] {
+            c.transpose();
+            doNotOptimize(c.getData());
+        });
+
+        suite.run("square", type, n, 2 * cube, 2 * bytes, [&] {
+            Matrix<T> square = a.Square();
+            doNotOptimize(square.getData());
+        });
+
+        // 16 needs four squarings, the averaging matrix stays the same in any power
+        suite.run("pow", type, n, 4 * 2 * cube, 2 * bytes, [&] {
+            Matrix<T> power = averaging.pow(16);
+            doNotOptimize(power.getData());
+        });
+
+        LUDecomposition<T> decomposition;
+        suite.run("lu_decompose", type, n, 2.0 / 3.0 * cube, 2 * bytes, [&] {
+            decomposition.decompose(a);
+            doNotOptimize(decomposition.getFactors().getData());
+        });
+
+        // a * a^T + n * I is symmetric positive-definite and well-conditioned
+        Matrix<T> spd = a * a.transposed();
+        for (std::size_t i = 0; i < n; ++i)
+            spd.set(i, i, spd.get(i, i) + static_cast<T>(n));
+
+        CholeskyDecomposition<T> cholesky;
+        suite.run("cholesky", type, n, 1.0 / 3.0 * cube, 1.5 * bytes, [&] {
+            cholesky.decompose(spd);
+            doNotOptimize(cholesky.logDeterminant());
+        });
+
+        QRDecomposition<T> qr;
+        suite.run("qr_decompose", type, n, 4.0 / 3.0 * cube, 2 * bytes, [&] {
+            qr.decompose(a);
+            doNotOptimize(qr.isRankDeficient());
+        });
+
+        if constexpr (std::is_same<T, double>::value) {
+            // Factors in float and refines in double, compare with lu_decompose
+            const std::vector<T> rightSide(n, T(1));
+            suite.run("mixed_lu_solve", type, n, 2.0 / 3.0 * cube, 2 * bytes, [&] {
+                MixedPrecisionLUDecomposition<T> mixed(a);
+                doNotOptimize(mixed.solve(rightSide).data());
+            });
+        }
+
+        suite.run("determinant", type, n, 2.0 / 3.0 * cube, 2 * bytes, [&] {
+            Determinant<T> determinant(a);
+            doNotOptimize(determinant.getDeterminant());
+        });
+    }
+}
+
+std::string escape(const std::string& text) {
+    std::string escaped;
+    for (char symbol : text) {
+        if (symbol == '"' || symbol == '\\')
+            escaped += '\\';
+        escaped += symbol;
+    }
+    return escaped;
+}
+
+bool writeJson(const std::string& path, const std::vector<Result>& results) {
+    std::ofstream file(path);
+    if (!file)
+        return false;
+
+    static const char* const simdNames[] = {"scalar", "sse2", "avx2", "avx512"};
+
+    file << "{\n  \"context\": {\n";
+    file << "    \"threads\": " << getThreadCount() << ",\n";
+    file << "    \"simd\": \"" << simdNames[static_cast<int>(getSimdLevel())] << "\",\n";
+#ifdef __VERSION__
+    file << "    \"compiler\": \"" << escape(__VERSION__) << "\",\n";
+#endif
+    file << "    \"samples\": " << Samples << "\n  },\n";
+    file << "  \"results\": [";
+
+    file.precision(17);
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        file << (i ? ",\n" : "\n");
+        file << "    {\"name\": \"" << escape(result.getName()) << "\", \"operation\": \"" << escape(result.operation)
+             << "\", \"type\": \"" << escape(result.type) << "\", \"size\": " << result.size
+             << ", \"iterations\": " << result.iterations << ", \"ns_per_op\": " << result.nsPerOp
+             << ", \"ns_per_op_min\": " << result.nsPerOpMin << ", \"gflops\": " << result.gflops
+             << ", \"gbps\": " << result.gbps << "}";
+    }
+    file << "\n  ]\n}\n";
+
+    return static_cast<bool>(file);
+}
+
+/**
+ * @brief Just enough of JSON to read files written by writeJson()
+ *
+ */
+struct JsonValue {
+    enum class Kind { Null, Boolean, Number, String, Array, Object };
+
+    Kind kind = Kind::Null;
+    double number = 0;
+    std::string text;
+    std::vector<JsonValue> items;
+    std::vector<std::pair<std::string, JsonValue>> members;
+
+    const JsonValue* find(const std::string& key) const {
+        for (const auto& member : members)
+            if (member.first == key)
+                return &member.second;
+        return nullptr;
+    }
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(const std::string& text) : mText(text), mPosition(0) {}
+
+    bool parse(JsonValue& value) {
+        return parseValue(value) && (skipSpaces(), mPosition == mText.size());
+    }
+
+private:
+    void skipSpaces() {
+        while (mPosition < mText.size() && std::strchr(" \t\r\n", mText[mPosition]) != nullptr)
+            ++mPosition;
+    }
+
+    bool consume(char symbol) {
+        skipSpaces();
+        if (mPosition < mText.size() && mText[mPosition] == symbol) {
+            ++mPosition;
+            return true;
+        }
+        return false;
+    }
+
+    bool consumeWord(const char* word) {
+        std::size_t length = std::strlen(word);
+        if (mText.compare(mPosition, length, word) != 0)
+            return false;
+        mPosition += length;
+        return true;
+    }
+
+    bool parseString(std::string& text) {
+        if (!consume('"'))
+            return false;
+
+        while (mPosition < mText.size() && mText[mPosition] != '"') {
+            if (mText[mPosition] == '\\' && ++mPosition == mText.size())
+                return false;
+            text += mText[mPosition++];
+        }
+        return consume('"');
+    }
+
+    bool parseValue(JsonValue& value) {
+        skipSpaces();
+        if (mPosition == mText.size())
+            return false;
+
+        char symbol = mText[mPosition];
+        if (symbol == '"') {
+            value.kind = JsonValue::Kind::String;
+            return parseString(value.text);
+        }
+
+        if (symbol == '[') {
+            value.kind = JsonValue::Kind::Array;
+            ++mPosition;
+            if (consume(']'))
+                return true;
+            do {
+                value.items.emplace_back();
+                if (!parseValue(value.items.back()))
+                    return false;
+            } while (consume(','));
+            return consume(']');
+        }
+
+        if (symbol == '{') {
+            value.kind = JsonValue::Kind::Object;
+            ++mPosition;
+            if (consume('}'))
+                return true;
+            do {
+                value.members.emplace_back();
+                if (!parseString(value.members.back().first) || !consume(':') || !parseValue(value.members.back().second))
+                    return false;
+            } while (consume(','));
+            return consume('}');
+        }
+
+        if (consumeWord("true") || consumeWord("false")) {
+            value.kind = JsonValue::Kind::Boolean;
+            value.number = symbol == 't';
+            return true;
+        }
+
+        if (consumeWord("null"))
+            return true;
+
+        const char* begin = mText.c_str() + mPosition;
+        char* end = nullptr;
+        value.kind = JsonValue::Kind::Number;
+        value.number = std::strtod(begin, &end);
+        mPosition += static_cast<std::size_t>(end - begin);
+        return end != begin;
+    }
+
+    const std::string& mText;
+    std::size_t mPosition;
+};
+
+/**
+ * @brief Reads time per operation of every benchmark in JSON file
+ *
+ */
+bool readJson(const std::string& path, std::vector<std::pair<std::string, double>>& times) {
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+
+    JsonValue root;
+    if (!file || !JsonParser(content.str()).parse(root))
+        return false;
+
+    const JsonValue* results = root.find("results");
+    if (results == nullptr || results->kind != JsonValue::Kind::Array)
+        return false;
+
+    for (const JsonValue& result : results->items) {
+        const JsonValue* name = result.find("name");
+        const JsonValue* time = result.find("ns_per_op");
+        if (name == nullptr || time == nullptr || time->kind != JsonValue::Kind::Number)
+            return false;
+        times.emplace_back(name->text, time->number);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Prints changes between two runs
+ *
+ * @return int Exit code: 0 if nothing got slower than threshold, 1 if something did, 2 on errors
+ */
+int compare(const std::string& basePath, const std::string& newPath, double threshold) {
+    std::vector<std::pair<std::string, double>> base, current;
+    if (!readJson(basePath, base) || !readJson(newPath, current)) {
+        std::fprintf(stderr, "Can't read benchmark results from %s or %s\n", basePath.c_str(), newPath.c_str());
+        return 2;
+    }
+
+    std::size_t regressions = 0;
+    std::printf("%-36s %14s %14s %9s\n", "benchmark", "base ns/op", "new ns/op", "change");
+
+    for (const auto& result : current) {
+        auto match = std::find_if(base.begin(), base.end(), [&](const std::pair<std::string, double>& entry) {
+            return entry.first == result.first;
+        });
+
+        if (match == base.end()) {
+            std::printf("%-36s %14s %14.1f %9s\n", result.first.c_str(), "-", result.second, "new");
+            continue;
+        }
+
+        double change = (result.second / match->second - 1) * 100;
+        const char* verdict = "";
+        if (change > threshold) {
+            verdict = "  REGRESSION";
+            ++regressions;
+        } else if (change < -threshold) {
+            verdict = "  improved";
+        }
+
+        std::printf("%-36s %14.1f %14.1f %+8.1f%%%s\n", result.first.c_str(), match->second, result.second, change, verdict);
+    }
+
+    std::printf("\n%zu regression(s) slower by more than %.1f%%\n", regressions, threshold);
+    return regressions > 0 ? 1 : 0;
+}
+
+template<typename T>
+std::vector<T> split(const std::string& list, T (*convert)(const std::string&)) {
+    std::vector<T> values;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ','))
+        if (!item.empty())
+            values.push_back(convert(item));
+    return values;
+}
+
+void printUsage() {
+    std::fprintf(stderr,
+                 "Usage: matrixcpp_bench [--sizes 16,64,256,1024] [--types float,double] [--filter text]\n"
+                 "                       [--min-time seconds] [--json file]\n"
+                 "       matrixcpp_bench --compare base.json new.json [--threshold percent]\n");
+}
+
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    std::string comparedBase, comparedNew;
+    double threshold = 10;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (argument == "--sizes" && hasValue) {
+            options.sizes = split<std::size_t>(argv[++i], [](const std::string& item) -> std::size_t { return std::strtoul(item.c_str(), nullptr, 10); });
+        } else if (argument == "--types" && hasValue) {
+            options.types = split<std::string>(argv[++i], [](const std::string& item) { return item; });
+        } else if (argument == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        } else if (argument == "--min-time" && hasValue) {
+            options.minTime = std::strtod(argv[++i], nullptr);
+        } else if (argument == "--json" && hasValue) {
+            options.json = argv[++i];
+        } else if (argument == "--compare" && i + 2 < argc) {
+            comparedBase = argv[++i];
+            comparedNew = argv[++i];
+        } else if (argument == "--threshold" && hasValue) {
+            threshold = std::strtod(argv[++i], nullptr);
+        } else {
+            printUsage();
+            return 2;
+        }
+    }
+
+    if (!comparedBase.empty())
+        return compare(comparedBase, comparedNew, threshold);
+
+    Suite suite(options);
+    for (const std::string& type : options.types) {
+        if (type == "float") {
+            runType<float>(suite, "float", options.sizes);
+        } else if (type == "double") {
+            runType<double>(suite, "double", options.sizes);
+        } else {
+            std::fprintf(stderr, "Unknown type %s (float and double are supported)\n", type.c_str());
+            return 2;
+        }
+    }
+
+    if (!options.json.empty() && !writeJson(options.json, suite.getResults())) {
+        std::fprintf(stderr, "Can't write %s\n", options.json.c_str());
+        return 2;
+    }
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+/**
+ * @brief Benchmark of multiplying matrix files tile by tile against multiplying in memory
+ *
+ * @file OutOfCoreBenchmark.cpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ *
+ * Build: g++ -std=c++17 -O3 -march=native -pthread -I.. OutOfCoreBenchmark.cpp -o OutOfCoreBenchmark
+ * Usage: OutOfCoreBenchmark [size] [budget in MiB, 0 for default] [directory for files]
+ */
+
+#include "../Matrix.hpp"
+#include "../OutOfCore.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+using namespace MatrixCpp;
+
+namespace {
+
+template<typename T>
+Matrix<T> randomMatrix(std::size_t rows, std::size_t columns, unsigned seed) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+    Matrix<T> matrix(rows, columns);
+    for (std::size_t r = 0; r < rows; ++r)
+        for (std::size_t c = 0; c < columns; ++c)
+            matrix.set(r, c, static_cast<T>(distribution(generator)));
+
+    return matrix;
+}
+
+template<typename F>
+double bestSeconds(F&& function, int runs = 3) {
+    double best = 1e30;
+
+    for (int run = 0; run < runs; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    return best;
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2048;
+    // By default (or 0) tiles hold an eighth of one operand, so the product really goes tile by tile
+    std::size_t budget = argc > 2 ? std::strtoul(argv[2], nullptr, 10) << 20 : 0;
+    if (budget == 0)
+        budget = n * n * sizeof(double) / 8 * 6;
+    std::string directory = argc > 3 ? argv[3] : ".";
+
+    std::string lhsPath = directory + "/outofcore_lhs.mtx", rhsPath = directory + "/outofcore_rhs.mtx",
+                resultPath = directory + "/outofcore_result.mtx";
+
+    Matrix<double> a = randomMatrix<double>(n, n, 1), b = randomMatrix<double>(n, n, 2);
+    if (!a.writeFile(lhsPath) || !b.writeFile(rhsPath)) {
+        std::fprintf(stderr, "Can't write files to %s\n", directory.c_str());
+        return 1;
+    }
+
+    double flops = 2.0 * n * n * n;
+    double inMemory = bestSeconds([&] {
+        Matrix<double> c = a * b;
+    });
+    bool done = true;
+    double fromFiles = bestSeconds([&] {
+        done = done && multiplyFiles<double>(lhsPath, rhsPath, resultPath, budget);
+    });
+
+    std::printf("Threads: %zu, size %zu, budget %.1f MiB\n", getThreadCount(), n, budget / 1048576.0);
+    std::printf("in memory  %7.3fs (%6.2f GFLOP/s)\n", inMemory, flops / inMemory * 1e-9);
+    std::printf("from files %7.3fs (%6.2f GFLOP/s, %.0f%% of in memory)%s\n", fromFiles, flops / fromFiles * 1e-9,
+                inMemory / fromFiles * 100, done ? "" : "  FAILED");
+
+    std::remove(lhsPath.c_str());
+    std::remove(rhsPath.c_str());
+    std::remove(resultPath.c_str());
+
+    return done ? 0 : 1;
+}
@@ -0,0 +1,79 @@
+/**
+ * @brief Benchmark of how matrix multiplication scales with number of threads
+ *
+ * @file ParallelGemmBenchmark.cpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ *
+ * Build: g++ -std=c++17 -O3 -march=native -pthread -I.. ParallelGemmBenchmark.cpp -o ParallelGemmBenchmark
+ * Usage: ParallelGemmBenchmark [size] [max threads]
+ */
+
+#include "../Matrix.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+
+using namespace MatrixCpp;
+
+namespace {
+
+template<typename T>
+Matrix<T> randomMatrix(std::size_t rows, std::size_t columns) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+    Matrix<T> matrix(rows, columns);
+    for (std::size_t r = 0; r < rows; ++r)
+        for (std::size_t c = 0; c < columns; ++c)
+            matrix.set(r, c, static_cast<T>(distribution(generator)));
+
+    return matrix;
+}
+
+template<typename T>
+double bestSeconds(const Matrix<T>& a, const Matrix<T>& b) {
+    double best = 1e30;
+
+    for (int run = 0; run < 3; ++run) {
+        Matrix<T> c;
+        c = a;
+        auto start = std::chrono::steady_clock::now();
+        c *= b;
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    return best;
+}
+
+template<typename T>
+void run(const char* type, std::size_t size, std::size_t maxThreads) {
+    Matrix<T> a = randomMatrix<T>(size, size), b = randomMatrix<T>(size, size);
+    double flops = 2.0 * size * size * size, serial = 0;
+
+    for (std::size_t threads = 1; threads <= maxThreads; threads = threads < maxThreads ? std::min(threads * 2, maxThreads) : threads + 1) {
+        setThreadCount(threads);
+        double seconds = bestSeconds(a, b);
+        if (threads == 1)
+            serial = seconds;
+
+        std::printf("%-6s %5zu  threads %3zu  %8.2f GFLOP/s  speedup %5.2fx  efficiency %5.1f%%\n",
+                    type, size, threads, flops / seconds * 1e-9, serial / seconds, 100.0 * serial / seconds / threads);
+    }
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::size_t size = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2048;
+    std::size_t maxThreads = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : std::thread::hardware_concurrency();
+    maxThreads = std::max<std::size_t>(maxThreads, 1);
+
+    run<double>("double", size, maxThreads);
+    run<float>("float", size, maxThreads);
+
+    return 0;
+}
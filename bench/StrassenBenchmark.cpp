@@ -0,0 +1,112 @@
+/**
+ * @brief Benchmark of Strassen-Winograd multiplication against the blocked kernel, finds the crossover
+ *
+ * @file StrassenBenchmark.cpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ *
+ * Build: g++ -std=c++17 -O3 -march=native -pthread -I.. StrassenBenchmark.cpp -o StrassenBenchmark
+ * Usage: StrassenBenchmark [max size]
+ */
+
+#include "../Matrix.hpp"
+#include "../Strassen.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+using namespace MatrixCpp;
+
+namespace {
+
+template<typename T>
+Matrix<T> randomMatrix(std::size_t rows, std::size_t columns) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+    Matrix<T> matrix(rows, columns);
+    for (std::size_t r = 0; r < rows; ++r)
+        for (std::size_t c = 0; c < columns; ++c)
+            matrix.set(r, c, static_cast<T>(distribution(generator)));
+
+    return matrix;
+}
+
+template<typename F>
+double bestSeconds(F&& function, double budget = 0.5) {
+    double best = 1e30, total = 0;
+    int runs = 0;
+
+    while (runs < 3 || (total < budget && runs < 20)) {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = std::min(best, seconds);
+        total += seconds;
+        ++runs;
+    }
+
+    return best;
+}
+
+/**
+ * @brief Prints time of blocked kernel, one level of recursion and full recursion,
+ * returns whether one level was faster
+ *
+ */
+template<typename T>
+bool run(const char* type, std::size_t n) {
+    Matrix<T> a = randomMatrix<T>(n, n), b = randomMatrix<T>(n, n), c(n, n);
+    double flops = 2.0 * n * n * n;
+
+    double blocked = bestSeconds([&] {
+        detail::gemm<T>(n, n, n, T(1), a.getData(), a.getStride(), 1, b.getData(), b.getStride(), 1, T(), c.getData(), c.getStride(), 1);
+    });
+    // Crossover of n stops recursion after one level, the halves go to the blocked kernel
+    double oneLevel = bestSeconds([&] {
+        detail::strassen<T>(n, n, n, T(1), a.getData(), a.getStride(), b.getData(), b.getStride(), T(), c.getData(), c.getStride(), n);
+    });
+    double recursive = bestSeconds([&] {
+        detail::strassen<T>(n, n, n, T(1), a.getData(), a.getStride(), b.getData(), b.getStride(), T(), c.getData(), c.getStride(), 256);
+    });
+
+    std::printf("%-6s %5zu  blocked %7.3fs (%6.2f GFLOP/s)  one level %7.3fs (%+6.1f%%)  down to 256 %7.3fs (%+6.1f%%)\n",
+                type, n, blocked, flops / blocked * 1e-9, oneLevel, (blocked / oneLevel - 1) * 100,
+                recursive, (blocked / recursive - 1) * 100);
+
+    return oneLevel < blocked;
+}
+
+template<typename T>
+void findCrossover(const char* type, std::size_t maxSize) {
+    std::size_t crossover = 0;
+    for (std::size_t n = 256; n <= maxSize; n += n / 4) {
+        // One faster size could be noise, so crossover is where one level stays faster
+        if (run<T>(type, n)) {
+            if (crossover == 0)
+                crossover = n;
+        } else {
+            crossover = 0;
+        }
+    }
+
+    if (crossover != 0)
+        std::printf("%s: one level of Strassen-Winograd wins from about %zu\n\n", type, crossover);
+    else
+        std::printf("%s: blocked kernel wins up to %zu\n\n", type, maxSize);
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::size_t maxSize = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4096;
+
+    std::printf("Threads: %zu, current crossover: %zu\n", getThreadCount(), getStrassenCrossover());
+    findCrossover<double>("double", maxSize);
+    findCrossover<float>("float", maxSize);
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+/**
+ * @brief Counts heap allocations of Matrix operations
+ *
+ * @file AllocationTest.cpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ *
+ * Global operator new is replaced by a counting one. Every operation runs once before it's counted,
+ * so the scratch arena of the thread already has room for temporaries, and the library is serial
+ * (setThreadCount(1)), so the thread pool doesn't allocate either.
+ */
+
+#include "../Matrix.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace {
+
+std::size_t allocations = 0;
+
+void* allocate(std::size_t bytes, std::size_t alignment) {
+    ++allocations;
+    void* memory = nullptr;
+    if (posix_memalign(&memory, std::max(alignment, sizeof(void*)), bytes ? bytes : 1) != 0)
+        throw std::bad_alloc();
+    return memory;
+}
+
+}
+
+void* operator new(std::size_t bytes) { return allocate(bytes, alignof(std::max_align_t)); }
+void* operator new[](std::size_t bytes) { return allocate(bytes, alignof(std::max_align_t)); }
+void* operator new(std::size_t bytes, std::align_val_t alignment) { return allocate(bytes, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t bytes, std::align_val_t alignment) { return allocate(bytes, static_cast<std::size_t>(alignment)); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+
+using namespace MatrixCpp;
+
+namespace {
+
+int failures = 0;
+
+/**
+ * @brief Runs operation once to warm up, then once more counting its allocations
+ *
+ */
+template<typename F>
+void expectAllocations(const char* name, std::size_t expected, const F& operation) {
+    operation();
+
+    std::size_t before = allocations;
+    operation();
+    std::size_t counted = allocations - before;
+
+    std::printf("%-28s %zu allocation(s)\n", name, counted);
+    if (counted != expected) {
+        std::printf("  FAILED: expected %zu\n", expected);
+        ++failures;
+    }
+}
+
+}
+
+int main() {
+    setThreadCount(1);
+
+    const std::size_t n = 64;
+    Matrix<double> a(n, n, 1.0), b(n, n, 2.0), wide(n, 2 * n, 3.0);
+
+    expectAllocations("copy construction", 1, [&] {
+        Matrix<double> copy(a);
+    });
+
+    Matrix<double> target(n, n);
+    expectAllocations("copy assignment, same shape", 0, [&] { target = a; });
+
+    expectAllocations("move construction/assignment", 0, [&] {
+        Matrix<double> moved(std::move(target));
+        target = std::move(moved);
+    });
+
+    expectAllocations("+=", 0, [&] { a += b; });
+    expectAllocations("-=", 0, [&] { a -= b; });
+    expectAllocations("*= scalar", 0, [&] { a *= 1.0; });
+    expectAllocations("*= matrix", 0, [&] { a *= b; });
+    expectAllocations("transpose() square", 0, [&] { a.transpose(); });
+    expectAllocations("transpose() rectangular", 0, [&] { wide.transpose(); });
+    expectAllocations("transposed()", 1, [&] { Matrix<double> t = wide.transposed(); });
+    expectAllocations("Square()", 1, [&] { Matrix<double> square = a.Square(); });
+    expectAllocations("getRowElements()", 1, [&] { std::vector<double> row = a.getRowElements(1); });
+    expectAllocations("getColumnElements()", 1, [&] { std::vector<double> column = a.getColumnElements(1); });
+    expectAllocations("getDiagonalElements()", 1, [&] { std::vector<double> diagonal = a.getDiagonalElements(); });
+    expectAllocations("getRow/getColumn/getDiagonal", 0, [&] {
+        double sum = 0;
+        for (double value : a.getRow(1))
+            sum += value;
+        for (double value : a.getColumn(1))
+            sum += value;
+        for (double value : a.getDiagonal())
+            sum += value;
+        a.set(0, 0, sum);
+    });
+
+    // Overflow blocks freed one at a time must not add up in the next main block of the arena
+    {
+        detail::ScratchArena& arena = detail::ScratchArena::get();
+        { detail::ScratchBuffer<char> warmUp(4096); }
+        const std::size_t megabyte = 1 << 20;
+        {
+            detail::ScratchBuffer<char> outer(64);
+            for (int i = 0; i < 200; ++i)
+                detail::ScratchBuffer<char> inner(megabyte);
+        }
+        std::printf("%-28s %zu byte(s)\n", "scratch arena capacity", arena.getCapacity());
+        if (arena.getCapacity() > 4096 + 2 * megabyte) {
+            std::printf("  FAILED: expected about one overflow block\n");
+            ++failures;
+        }
+    }
+
+    if (failures != 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
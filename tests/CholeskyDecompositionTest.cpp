@@ -0,0 +1,123 @@
+/**
+ * @brief Checks tiled Cholesky decomposition around the tile boundary
+ *
+ * @file CholeskyDecompositionTest.cpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ *
+ * Sizes 127, 128 and 129 give one partial tile, one full tile and a full tile followed by a 1 x 1 one.
+ * Four threads, so tiles and chunks of right-hand sides run as separate tasks even on a single core.
+ */
+
+#include "../CholeskyDecomposition.hpp"
+#include "../LUDecomposition.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace MatrixCpp;
+
+namespace {
+
+int failures = 0;
+
+void expect(std::size_t size, const char* name, bool passed) {
+    std::printf("%-5zu %-28s %s\n", size, name, passed ? "ok" : "FAILED");
+    if (!passed)
+        ++failures;
+}
+
+Matrix<double> randomMatrix(std::size_t rows, std::size_t columns, std::mt19937& generator) {
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+    Matrix<double> matrix(rows, columns);
+    for (std::size_t row = 0; row < rows; ++row)
+        for (std::size_t column = 0; column < columns; ++column)
+            matrix.set(row, column, distribution(generator));
+    return matrix;
+}
+
+/**
+ * @brief Largest absolute difference of elements (infinity if shapes don't match)
+ *
+ */
+double maxDifference(const Matrix<double>& lhs, const Matrix<double>& rhs) {
+    if (lhs.getRows() != rhs.getRows() || lhs.getColumns() != rhs.getColumns())
+        return INFINITY;
+
+    double difference = 0;
+    for (std::size_t row = 0; row < lhs.getRows(); ++row)
+        for (std::size_t column = 0; column < lhs.getColumns(); ++column)
+            difference = std::max(difference, std::abs(lhs.get(row, column) - rhs.get(row, column)));
+    return difference;
+}
+
+void check(std::size_t size, std::mt19937& generator) {
+    // M * M^T + size * I is symmetric positive-definite and well-conditioned
+    const Matrix<double> m = randomMatrix(size, size, generator);
+    Matrix<double> a = m * m.transposed();
+    for (std::size_t i = 0; i < size; ++i)
+        a.set(i, i, a.get(i, i) + static_cast<double>(size));
+
+    const CholeskyDecomposition<double> cholesky(a);
+    const double tolerance = 1e-10 * static_cast<double>(size);
+    expect(size, "decomposed", !cholesky.isEmpty() && cholesky.getSize() == size);
+
+    const std::shared_ptr<Matrix<double>> factor = cholesky.getL();
+    const Matrix<double>& l = *factor;
+    bool lower = l.getRows() == size && l.getColumns() == size;
+    for (std::size_t row = 0; lower && row < size; ++row)
+        for (std::size_t column = row + 1; column < size; ++column)
+            lower &= l.get(row, column) == 0.0;
+    expect(size, "L is lower triangular", lower);
+    expect(size, "L * L^T == A", maxDifference(l * l.transposed(), a) <= tolerance);
+
+    const Matrix<double> b = randomMatrix(size, 1, generator);
+    const std::vector<double> x = cholesky.solve(b.getColumnElements(0));
+    Matrix<double> column(size, 1);
+    if (x.size() == size)
+        std::copy(x.begin(), x.end(), column.getData());
+    expect(size, "solve vector", x.size() == size && maxDifference(a * column, b) <= tolerance);
+
+    // More columns than one chunk of right-hand sides
+    const Matrix<double> B = randomMatrix(size, 300, generator);
+    expect(size, "solve matrix", maxDifference(a * cholesky.solve(B), B) <= tolerance);
+
+    const LUDecomposition<double> lu(a);
+    double logDeterminant = 0;
+    for (std::size_t i = 0; i < size; ++i)
+        logDeterminant += std::log(std::abs(lu.getFactors().get(i, i)));
+    expect(size, "logDeterminant vs LU", std::abs(cholesky.logDeterminant() - logDeterminant) <= 1e-9 * std::abs(logDeterminant));
+
+    // Symmetric but indefinite: the last pivot becomes negative
+    Matrix<double> indefinite = a;
+    indefinite.set(size - 1, size - 1, -1.0);
+    const CholeskyDecomposition<double> failed(indefinite);
+    expect(size, "indefinite input is empty", failed.isEmpty() && !failed.getL() &&
+                                              failed.solve(B).getRows() == 0 && failed.solve(x).empty());
+}
+
+}
+
+int main() {
+    setThreadCount(4);
+    std::mt19937 generator(13);
+
+    check(127, generator);
+    check(128, generator);
+    check(129, generator);
+
+    expect(3, "non-square input is empty", CholeskyDecomposition<double>(Matrix<double>(3, 4, 1.0)).isEmpty());
+
+    if (failures != 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,114 @@
+/**
+ * @brief Checks MatrixBatch against the same operations on separate matrices
+ *
+ * @file MatrixBatchTest.cpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ */
+
+#include "../Determinant.hpp"
+#include "../LUDecomposition.hpp"
+#include "../MatrixBatch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace MatrixCpp;
+
+namespace {
+
+int failures = 0;
+
+void expect(const char* name, bool passed) {
+    std::printf("%-36s %s\n", name, passed ? "ok" : "FAILED");
+    if (!passed)
+        ++failures;
+}
+
+bool isClose(double value, double expected) {
+    return std::abs(value - expected) <= 1e-9 * std::max(1.0, std::abs(expected));
+}
+
+bool isClose(const Matrix<double>& matrix, const Matrix<double>& expected) {
+    if (matrix.getRows() != expected.getRows() || matrix.getColumns() != expected.getColumns())
+        return false;
+
+    for (std::size_t row = 0; row < matrix.getRows(); ++row)
+        for (std::size_t column = 0; column < matrix.getColumns(); ++column)
+            if (!isClose(matrix.get(row, column), expected.get(row, column)))
+                return false;
+    return true;
+}
+
+MatrixBatch<double> randomBatch(std::size_t count, std::size_t rows, std::size_t columns, std::mt19937& generator) {
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+    MatrixBatch<double> batch(count, rows, columns);
+    for (std::size_t index = 0; index < count; ++index)
+        for (std::size_t row = 0; row < rows; ++row)
+            for (std::size_t column = 0; column < columns; ++column)
+                batch.set(index, row, column, distribution(generator));
+    return batch;
+}
+
+}
+
+int main() {
+    // More than one chunk of batch elements, the last one partial
+    const std::size_t count = 600, n = 5;
+    std::mt19937 generator(7);
+
+    MatrixBatch<double> a = randomBatch(count, n, n, generator);
+    MatrixBatch<double> b = randomBatch(count, n, 3, generator);
+
+    // Two singular matrices: a zero column and two equal rows
+    const std::size_t zeroColumn = 3, equalRows = 300;
+    for (std::size_t row = 0; row < n; ++row)
+        a.set(zeroColumn, row, 2, 0.0);
+    for (std::size_t column = 0; column < n; ++column)
+        a.set(equalRows, 4, column, a.get(equalRows, 1, column));
+
+    std::vector<double> determinants = a.getDeterminants();
+    bool determinantsMatch = determinants.size() == count;
+    for (std::size_t index = 0; determinantsMatch && index < count; ++index)
+        determinantsMatch = isClose(determinants[index], Determinant<double>(a.getMatrix(index)).getDeterminant());
+    expect("getDeterminants vs Determinant", determinantsMatch);
+
+    std::vector<bool> singular;
+    MatrixBatch<double> x = a.solve(b, singular);
+    bool solutionsMatch = x.getCount() == count && singular.size() == count;
+    for (std::size_t index = 0; solutionsMatch && index < count; ++index) {
+        LUDecomposition<double> decomposition(a.getMatrix(index));
+        solutionsMatch = singular[index] == decomposition.isSingular();
+        if (!solutionsMatch)
+            break;
+
+        if (decomposition.isSingular())
+            solutionsMatch = isClose(x.getMatrix(index), Matrix<double>(n, 3));
+        else
+            solutionsMatch = isClose(x.getMatrix(index), decomposition.solve(b.getMatrix(index)));
+    }
+    expect("solve vs LUDecomposition", solutionsMatch);
+    expect("singular flags", singular.size() == count && singular[zeroColumn] && singular[equalRows] &&
+                             std::count(singular.begin(), singular.end(), true) == 2);
+
+    MatrixBatch<double> products = a * b;
+    bool productsMatch = products.getCount() == count && products.getRows() == n && products.getColumns() == 3;
+    for (std::size_t index = 0; productsMatch && index < count; ++index)
+        productsMatch = isClose(products.getMatrix(index), a.getMatrix(index) * b.getMatrix(index));
+    expect("operator* vs Matrix", productsMatch);
+
+    MatrixBatch<double> wrongShape = randomBatch(count, n + 1, 1, generator);
+    expect("solve with mismatched shapes", a.solve(wrongShape, singular).getCount() == 0 && singular.empty());
+
+    if (failures != 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
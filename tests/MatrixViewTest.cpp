@@ -0,0 +1,103 @@
+/**
+ * @brief Checks views of rows, columns, diagonals and blocks of matrix
+ *
+ * @file MatrixViewTest.cpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ */
+
+#include "../Matrix.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+
+using namespace MatrixCpp;
+
+namespace {
+
+int failures = 0;
+
+/**
+ * @brief Makes rows x columns matrix with element (i, j) equal to 10 * i + j
+ *
+ */
+Matrix<double> numbered(std::size_t rows, std::size_t columns) {
+    Matrix<double> matrix(rows, columns);
+    for (std::size_t row = 0; row < rows; ++row)
+        for (std::size_t column = 0; column < columns; ++column)
+            matrix.set(row, column, 10.0 * row + column);
+    return matrix;
+}
+
+void expectElements(const char* name, const Matrix<double>& matrix, std::initializer_list<double> expected) {
+    bool equal = matrix.getRows() * matrix.getColumns() == expected.size();
+    const double* value = expected.begin();
+    for (std::size_t row = 0; equal && row < matrix.getRows(); ++row)
+        for (std::size_t column = 0; column < matrix.getColumns(); ++column)
+            equal &= matrix.get(row, column) == *value++;
+
+    std::printf("%-36s %s\n", name, equal ? "ok" : "FAILED");
+    if (!equal)
+        ++failures;
+}
+
+}
+
+int main() {
+    {
+        Matrix<double> m = numbered(3, 3);
+        m.getRow(1)[2] = -1;
+        m.getColumn(0)[2] = -2;
+        m.getDiagonal()[0] = -3;
+        expectElements("row, column and diagonal writes", m, {-3, 1, 2, 10, 11, -1, -2, 21, 22});
+    }
+
+    {
+        Matrix<double> m = numbered(3, 4);
+        Matrix<double> block(m.getSubMatrix(1, 1, 2, 2));
+        expectElements("block copy", block, {11, 12, 21, 22});
+
+        m.getSubMatrix(0, 2, 2, 2) = m.getSubMatrix(1, 0, 2, 2);
+        expectElements("disjoint blocks", m, {0, 1, 10, 11, 10, 11, 20, 21, 20, 21, 22, 23});
+    }
+
+    {
+        Matrix<double> m = numbered(4, 2);
+        m.getSubMatrix(1, 0, 3, 2) = m.getSubMatrix(0, 0, 3, 2);
+        expectElements("overlapping blocks, rows down", m, {0, 1, 0, 1, 10, 11, 20, 21});
+    }
+
+    {
+        Matrix<double> m = numbered(4, 2);
+        m.getSubMatrix(0, 0, 3, 2) = m.getSubMatrix(1, 0, 3, 2);
+        expectElements("overlapping blocks, rows up", m, {10, 11, 20, 21, 30, 31, 30, 31});
+    }
+
+    {
+        Matrix<double> m = numbered(2, 4);
+        m.getSubMatrix(0, 1, 2, 3) = m.getSubMatrix(0, 0, 2, 3);
+        expectElements("overlapping blocks, columns right", m, {0, 0, 1, 2, 10, 10, 11, 12});
+    }
+
+    {
+        Matrix<double> m = numbered(4, 2);
+        m.getSubMatrix(1, 0, 3, 2) += m.getSubMatrix(0, 0, 3, 2) * 2.0;
+        expectElements("overlapping compound assignment", m, {0, 1, 10, 13, 40, 43, 70, 73});
+    }
+
+    {
+        Matrix<double> m = numbered(2, 2);
+        SubMatrixView<double> all = m.getSubMatrix(0, 0, 2, 2);
+        all += all;
+        expectElements("block plus itself", m, {0, 2, 20, 22});
+    }
+
+    if (failures != 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
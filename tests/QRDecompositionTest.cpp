@@ -0,0 +1,122 @@
+/**
+ * @brief Checks QR decomposition of square, slightly tall and TSQR-sized matrices
+ *
+ * @file QRDecompositionTest.cpp
+ * @author Kirill Shepelev
+ * @date 2026-10-17
+ *
+ * Four threads, so passes over rows of tall matrices are split into chunks even on a single core.
+ */
+
+#include "../LUDecomposition.hpp"
+#include "../QRDecomposition.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+
+using namespace MatrixCpp;
+
+namespace {
+
+int failures = 0;
+
+void expect(const char* shape, const char* name, bool passed) {
+    std::printf("%-10s %-32s %s\n", shape, name, passed ? "ok" : "FAILED");
+    if (!passed)
+        ++failures;
+}
+
+Matrix<double> randomMatrix(std::size_t rows, std::size_t columns, std::mt19937& generator) {
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+    Matrix<double> matrix(rows, columns);
+    for (std::size_t row = 0; row < rows; ++row)
+        for (std::size_t column = 0; column < columns; ++column)
+            matrix.set(row, column, distribution(generator));
+    return matrix;
+}
+
+/**
+ * @brief Largest absolute difference of elements (infinity if shapes don't match)
+ *
+ */
+double maxDifference(const Matrix<double>& lhs, const Matrix<double>& rhs) {
+    if (lhs.getRows() != rhs.getRows() || lhs.getColumns() != rhs.getColumns())
+        return INFINITY;
+
+    double difference = 0;
+    for (std::size_t row = 0; row < lhs.getRows(); ++row)
+        for (std::size_t column = 0; column < lhs.getColumns(); ++column)
+            difference = std::max(difference, std::abs(lhs.get(row, column) - rhs.get(row, column)));
+    return difference;
+}
+
+void check(std::size_t rows, std::size_t columns, std::mt19937& generator) {
+    char shape[32];
+    std::snprintf(shape, sizeof(shape), "%zux%zu", rows, columns);
+
+    const Matrix<double> a = randomMatrix(rows, columns, generator);
+    const QRDecomposition<double> qr(a);
+    const double tolerance = 1e-10 * std::sqrt(static_cast<double>(rows));
+
+    expect(shape, "decomposed", !qr.isEmpty() && !qr.isRankDeficient());
+
+    const std::shared_ptr<Matrix<double>> factorQ = qr.getQ(), factorR = qr.getR();
+    const Matrix<double>& q = *factorQ;
+    const Matrix<double>& r = *factorR;
+    expect(shape, "Q * R == A", maxDifference(q * r, a) <= tolerance);
+
+    bool upper = r.getRows() == columns && r.getColumns() == columns;
+    for (std::size_t row = 0; upper && row < columns; ++row)
+        for (std::size_t column = 0; column < row; ++column)
+            upper &= r.get(row, column) == 0.0;
+    expect(shape, "R is upper triangular", upper);
+
+    Matrix<double> identity(columns, columns);
+    for (std::size_t i = 0; i < columns; ++i)
+        identity.set(i, i, 1.0);
+    expect(shape, "Q^T * Q == I", maxDifference(q.transposed() * q, identity) <= tolerance);
+
+    const Matrix<double> c = randomMatrix(rows, 3, generator);
+    expect(shape, "applyQ(applyQTransposed(C)) == C", maxDifference(qr.applyQ(qr.applyQTransposed(c)), c) <= tolerance);
+
+    // Least squares solution solves the normal equations A^T * A * x = A^T * b
+    const Matrix<double> b = randomMatrix(rows, 2, generator);
+    const Matrix<double> transposed = a.transposed();
+    const Matrix<double> normal = LUDecomposition<double>(transposed * a).solve(transposed * b);
+    const Matrix<double> x = qr.solve(b);
+    double scale = 1.0;
+    for (std::size_t row = 0; row < normal.getRows(); ++row)
+        scale = std::max(scale, std::abs(normal.get(row, 0)));
+    expect(shape, "solve vs normal equations", maxDifference(x, normal) <= 1e-8 * scale);
+}
+
+}
+
+int main() {
+    setThreadCount(4);
+    std::mt19937 generator(11);
+
+    // Blocked with recursive panels, the same slightly tall, and stacked chunks of rows (TSQR)
+    check(100, 100, generator);
+    check(150, 100, generator);
+    check(40000, 20, generator);
+
+    // Reflectors keep a zero column exactly zero, so R gets zero on the diagonal
+    Matrix<double> deficient = randomMatrix(40000, 20, generator);
+    for (std::size_t row = 0; row < deficient.getRows(); ++row)
+        deficient.set(row, 7, 0.0);
+    const QRDecomposition<double> qr(deficient);
+    expect("40000x20", "rank deficient input", qr.isRankDeficient() && qr.solve(Matrix<double>(40000, 1)).getRows() == 0);
+
+    if (failures != 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}